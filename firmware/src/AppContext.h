@@ -2,8 +2,8 @@
 #pragma once
 #include <stdint.h>
 #include <driver/gpio.h>
+#include "DisplayBackend.h"
 
-class IDisplayManager;
 class IInputManager;
 class ITemperatureController;
 struct ScreensManager;
@@ -17,6 +17,8 @@ class WiFiResetView;
 class DataDisplayView;
 class ConfirmTimezoneView;
 class PowerOffView;
+class ChartView;
+class MenuView;
 namespace services { struct INetworkService; struct IStorage; }
 
 namespace services {
@@ -24,7 +26,7 @@ namespace services {
 }
 
 struct AppContext {
-    IDisplayManager* display = nullptr;
+    DisplayBackend* display = nullptr;
     IInputManager* input = nullptr;
     ITemperatureController* tempController = nullptr;
     ScreensManager* screens = nullptr;
@@ -49,4 +51,6 @@ struct AppContext {
     DataDisplayView* dataDisplayView = nullptr;
     ConfirmTimezoneView* confirmTimezoneView = nullptr;
     PowerOffView* powerOffView = nullptr;
+    ChartView* chartView = nullptr;
+    MenuView* menuView = nullptr;
 };
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Tracks which 8x8 tiles of the 128x64 SH1106 frame buffer changed, as one inclusive span of
+// tile columns per tile row. The buffer is organised as 8 rows of 16 tiles.
+class DirtyTiles {
+public:
+    static constexpr uint8_t TILE_SIZE = 8;
+    static constexpr uint8_t ROWS = 64 / TILE_SIZE;
+    static constexpr uint8_t COLUMNS = 128 / TILE_SIZE;
+
+    DirtyTiles() { clear(); }
+
+    // Mark the tiles covered by a pixel rectangle, clipped to the screen
+    void mark(int16_t x, int16_t y, int16_t w, int16_t h) {
+        const int16_t x1 = min<int16_t>(x + w, COLUMNS * TILE_SIZE);
+        const int16_t y1 = min<int16_t>(y + h, ROWS * TILE_SIZE);
+        x = max<int16_t>(x, 0);
+        y = max<int16_t>(y, 0);
+        if (x >= x1 || y >= y1) {
+            return;
+        }
+        for (uint8_t row = y / TILE_SIZE; row <= (y1 - 1) / TILE_SIZE; row++) {
+            markColumns(row, x / TILE_SIZE, (x1 - 1) / TILE_SIZE);
+        }
+    }
+
+    void markColumns(uint8_t row, uint8_t firstColumn, uint8_t lastColumn) {
+        _firstColumn[row] = min(_firstColumn[row], firstColumn);
+        _lastColumn[row] = max(_lastColumn[row], lastColumn);
+    }
+
+    void markAll() {
+        memset(_firstColumn, 0, sizeof(_firstColumn));
+        memset(_lastColumn, COLUMNS - 1, sizeof(_lastColumn));
+    }
+
+    void clear() {
+        memset(_firstColumn, UINT8_MAX, sizeof(_firstColumn));
+        memset(_lastColumn, 0, sizeof(_lastColumn));
+    }
+
+    void clearRow(uint8_t row) {
+        _firstColumn[row] = UINT8_MAX;
+        _lastColumn[row] = 0;
+    }
+
+    bool isRowDirty(uint8_t row) const { return _firstColumn[row] <= _lastColumn[row]; }
+    uint8_t firstColumn(uint8_t row) const { return _firstColumn[row]; }
+    uint8_t columnCount(uint8_t row) const { return _lastColumn[row] - _firstColumn[row] + 1; }
+
+private:
+    // A row is clean when its first column is past its last one
+    uint8_t _firstColumn[ROWS];
+    uint8_t _lastColumn[ROWS];
+};
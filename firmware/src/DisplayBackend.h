@@ -0,0 +1,12 @@
+#pragma once
+
+// The display type views, menus and controllers draw through. It is chosen at compile time so
+// every primitive is a direct (and usually inlined) call rather than a virtual one. Host tests
+// define DISPLAY_BACKEND_HOST to render into memory instead (see tools/host/HostDisplay.h).
+#ifdef DISPLAY_BACKEND_HOST
+#include "HostDisplay.h"
+using DisplayBackend = HostDisplay;
+#else
+#include "DisplayManager.h"
+using DisplayBackend = DisplayManager;
+#endif
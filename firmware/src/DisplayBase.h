@@ -0,0 +1,221 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Fonts.h"
+
+// Screen furniture shared by every display backend, written once against the backend's own
+// primitives. Derived is the concrete backend (CRTP), so these calls are resolved at compile time.
+// Title and button bar layouts are measured once and cached.
+template <typename Derived>
+class DisplayBase {
+public:
+    uint8_t drawTitle(const char* title, const uint8_t y = 10) {
+        Derived& display = derived();
+        display.setFont(fonts::REGULAR);
+        display.setDrawColor(1);
+        const TitleLayout& layout = titleLayout(title);
+
+        char line[MAX_TITLE_LENGTH];
+        uint8_t currentY = y; // Initial Y position for drawing
+        for (uint8_t i = 0; i < layout.lineCount; i++) {
+            // Draw each line at its precomputed, centered position
+            memcpy(line, title + layout.lines[i].start, layout.lines[i].length);
+            line[layout.lines[i].length] = '\0';
+            display.drawUTF8(layout.lines[i].x, currentY, line);
+            currentY += layout.lineHeight; // Move Y position down
+        }
+        // Lines past MAX_TITLE_LINES are not cached: split and measure them as they are drawn
+        uint8_t start = layout.uncachedStart;
+        while (start < MAX_TITLE_LENGTH - 1 && title[start]) {
+            const uint8_t end = lineEnd(title, start);
+            if (end > start) {
+                memcpy(line, title + start, end - start);
+                line[end - start] = '\0';
+                display.drawUTF8((display.getDisplayWidth() - display.getUTF8Width(line)) / 2, currentY, line);
+                currentY += layout.lineHeight;
+            }
+            start = title[end] == '\n' ? end + 1 : end;
+        }
+        return currentY + layout.lineHeight;
+    }
+
+    void drawButtons(const char* buttonTexts[], uint8_t buttonCount, int8_t selectedButton = -1) {
+        Derived& display = derived();
+        display.setFont(fonts::REGULAR);
+        const ButtonLayout& layout = buttonLayout(buttonTexts, buttonCount);
+        const uint8_t buttonsY = display.getDisplayHeight() - BUTTON_HEIGHT;
+        if (selectedButton >= layout.count) {
+            selectedButton = -1;
+        }
+
+        if (_shownButtons == &layout) {
+            // Same bar already on screen: only move the highlight, each box being XOR-ed in place
+            if (selectedButton != _shownSelection) {
+                display.setDrawColor(2);
+                if (_shownSelection >= 0) drawHighlight(layout, _shownSelection, buttonsY);
+                if (selectedButton >= 0) drawHighlight(layout, selectedButton, buttonsY);
+                _shownSelection = selectedButton;
+            }
+            return;
+        }
+
+        display.setDrawColor(0);
+        display.drawBox(0, buttonsY, display.getDisplayWidth(), BUTTON_HEIGHT);
+        display.setDrawColor(1);
+        for (uint8_t i = 0; i < layout.count; i++) {
+            display.drawUTF8(layout.textX[i], display.getDisplayHeight() - BUTTON_PADDING, buttonTexts[i]);
+        }
+        if (selectedButton >= 0) {
+            display.setDrawColor(2);
+            drawHighlight(layout, selectedButton, buttonsY);
+        }
+        _shownButtons = &layout;
+        _shownSelection = selectedButton;
+    }
+
+protected:
+    DisplayBase() = default;
+
+    // Backends call this whenever the frame buffer is wiped, so the next button bar is drawn in full
+    void onBufferCleared() { _shownButtons = nullptr; }
+
+private:
+    static constexpr uint8_t MAX_TITLE_LENGTH = 100;
+    static constexpr uint8_t MAX_TITLE_LINES = 5;  // As many as fit on the screen; any more are drawn uncached
+    static constexpr uint8_t TITLE_CACHE_SIZE = 8;
+    static constexpr uint8_t MAX_BUTTONS = 3;
+    static constexpr uint8_t BUTTON_CACHE_SIZE = 6;
+    static constexpr uint8_t BUTTON_HEIGHT = 13;
+    static constexpr uint8_t BUTTON_PADDING = 3;
+    static constexpr uint8_t SINGLE_BUTTON_SIDE_PADDING = 7;
+
+    struct TitleLine {
+        uint8_t start;
+        uint8_t length;
+        uint8_t x;
+    };
+
+    // Keyed by pointer and content hash, since some titles are formatted into reused stack buffers
+    struct TitleLayout {
+        const char* title = nullptr;
+        uint32_t hash = 0;
+        uint8_t lineHeight = 0;
+        uint8_t lineCount = 0;
+        uint8_t uncachedStart = 0;  // Offset of the first line past MAX_TITLE_LINES, at the end of the title if none
+        TitleLine lines[MAX_TITLE_LINES];
+    };
+
+    // Keyed by the label pointers, which are string literals
+    struct ButtonLayout {
+        const char* labels[MAX_BUTTONS] = {};
+        uint8_t count = 0;
+        uint8_t textX[MAX_BUTTONS];
+        uint8_t boxX[MAX_BUTTONS];
+        uint8_t boxWidth[MAX_BUTTONS];
+    };
+
+    TitleLayout _titleLayouts[TITLE_CACHE_SIZE];
+    uint8_t _nextTitleLayout = 0;
+    ButtonLayout _buttonLayouts[BUTTON_CACHE_SIZE];
+    uint8_t _nextButtonLayout = 0;
+    // Button bar currently in the frame buffer, if any, and its highlighted button
+    const ButtonLayout* _shownButtons = nullptr;
+    int8_t _shownSelection = -1;
+
+    Derived& derived() { return static_cast<Derived&>(*this); }
+
+    // End of the title line starting at start, on EOL or at the end of the drawable part
+    static uint8_t lineEnd(const char* title, uint8_t start) {
+        uint8_t end = start;
+        while (end < MAX_TITLE_LENGTH - 1 && title[end] && title[end] != '\n') {
+            end++;
+        }
+        return end;
+    }
+
+    static uint32_t hashTitle(const char* title) {
+        // FNV-1a over the part of the title that can be drawn
+        uint32_t hash = 2166136261u;
+        for (uint8_t i = 0; i < MAX_TITLE_LENGTH - 1 && title[i]; i++) {
+            hash = (hash ^ static_cast<uint8_t>(title[i])) * 16777619u;
+        }
+        return hash;
+    }
+
+    const TitleLayout& titleLayout(const char* title) {
+        const uint32_t hash = hashTitle(title);
+        for (const TitleLayout& layout : _titleLayouts) {
+            if (layout.title == title && layout.hash == hash) {
+                return layout;
+            }
+        }
+
+        Derived& display = derived();
+        TitleLayout& layout = _titleLayouts[_nextTitleLayout];
+        _nextTitleLayout = (_nextTitleLayout + 1) % TITLE_CACHE_SIZE;
+        layout.title = title;
+        layout.hash = hash;
+        layout.lineHeight = display.getAscent() - display.getDescent() + 2; // Line height (font height + spacing)
+        layout.lineCount = 0;
+
+        // Split the title into lines on EOL, skipping empty lines
+        char line[MAX_TITLE_LENGTH];
+        uint8_t start = 0;
+        while (start < MAX_TITLE_LENGTH - 1 && title[start] && layout.lineCount < MAX_TITLE_LINES) {
+            const uint8_t end = lineEnd(title, start);
+            if (end > start) {
+                memcpy(line, title + start, end - start);
+                line[end - start] = '\0';
+                TitleLine& titleLine = layout.lines[layout.lineCount++];
+                titleLine.start = start;
+                titleLine.length = end - start;
+                titleLine.x = (display.getDisplayWidth() - display.getUTF8Width(line)) / 2;
+            }
+            start = title[end] == '\n' ? end + 1 : end;
+        }
+        layout.uncachedStart = start;
+        return layout;
+    }
+
+    const ButtonLayout& buttonLayout(const char* buttonTexts[], uint8_t buttonCount) {
+        buttonCount = min<uint8_t>(buttonCount, MAX_BUTTONS);
+        for (const ButtonLayout& layout : _buttonLayouts) {
+            if (layout.count == buttonCount && memcmp(layout.labels, buttonTexts, buttonCount * sizeof(const char*)) == 0) {
+                return layout;
+            }
+        }
+
+        Derived& display = derived();
+        ButtonLayout& layout = _buttonLayouts[_nextButtonLayout];
+        _nextButtonLayout = (_nextButtonLayout + 1) % BUTTON_CACHE_SIZE;
+        if (_shownButtons == &layout) {
+            _shownButtons = nullptr;
+        }
+        memcpy(layout.labels, buttonTexts, buttonCount * sizeof(const char*));
+        layout.count = buttonCount;
+
+        const uint8_t screenWidth = display.getDisplayWidth();
+        if (buttonCount == 1) {
+            const uint8_t buttonWidth = display.getUTF8Width(buttonTexts[0]) + 2 * SINGLE_BUTTON_SIDE_PADDING;
+            layout.boxX[0] = (screenWidth - buttonWidth) / 2;
+            layout.boxWidth[0] = buttonWidth;
+            layout.textX[0] = layout.boxX[0] + SINGLE_BUTTON_SIDE_PADDING;
+        } else {
+            const uint8_t buttonAreaWidth = screenWidth / buttonCount;
+            for (uint8_t i = 0; i < buttonCount; i++) {
+                layout.boxX[i] = i * buttonAreaWidth;
+                layout.boxWidth[i] = buttonAreaWidth;
+                layout.textX[i] = layout.boxX[i] + (buttonAreaWidth - display.getUTF8Width(buttonTexts[i])) / 2;
+            }
+        }
+        return layout;
+    }
+
+    void drawHighlight(const ButtonLayout& layout, uint8_t button, uint8_t buttonsY) {
+        derived().drawRBox(layout.boxX[button], buttonsY, layout.boxWidth[button], BUTTON_HEIGHT, 1);
+    }
+};
+
+// Bound to a reference by min(), so C++11 needs the definition as well
+template <typename Derived>
+constexpr uint8_t DisplayBase<Derived>::MAX_BUTTONS;
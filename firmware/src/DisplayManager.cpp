@@ -1,43 +1,147 @@
+#include <esp_timer.h>
 #include "DisplayManager.h"
-
-DisplayManager::DisplayManager(const u8g2_cb_t * rotation) : _display(rotation) {}
+#include "DebugUtils.h"
+#include "Fonts.h"
+
+DisplayManager::DisplayManager(const u8g2_cb_t * rotation) :
+    _display(rotation),
+    _fullFlushOnly(rotation != U8G2_R0),
+    _framePending(false),
+    _lastFrameTime(0),
+    _font(nullptr),
+    _drawColor(1),
+    _panelState(PanelState::On),
+    _lastInputTime(0),
+    _requestedPanelState(PanelState::On),
+    _appliedPanelState(PanelState::On),
+    _frontLock(nullptr),
+    _flushTask(nullptr)
+{
+    _dirty.markAll();
+}
 
 void DisplayManager::begin() {
     _display.begin();
+    // Decode the numeric glyphs of the readout fonts once, using the frame buffer as scratch space.
+    // Cached glyphs are stored unrotated, so a rotated display always goes through U8g2.
+    if (!_fullFlushOnly) {
+        _glyphCache.add(_display.getU8g2(), fonts::REGULAR);
+        _glyphCache.add(_display.getU8g2(), fonts::LARGE);
+        _display.clearBuffer();
+        if (_font) _display.setFont(_font);
+        _display.setFontMode(0);
+        _display.setDrawColor(_drawColor);
+    }
+    _dirty.markAll();
+    _lastInputTime = (uint32_t)(esp_timer_get_time() / 1000ULL);
+    if (_flushTask) {
+        return;
+    }
+    _frontLock = xSemaphoreCreateMutex();
+    if (!_frontLock || xTaskCreate(&DisplayManager::flushTask, "display", FLUSH_TASK_STACK_SIZE, this, FLUSH_TASK_PRIORITY, &_flushTask) != pdPASS) {
+        // Without the task, sendBuffer() transfers synchronously
+        _flushTask = nullptr;
+        DEBUG_PRINTLN("DisplayManager: failed to start flush task");
+    }
 }
 
 void DisplayManager::update() {
-    _display.firstPage();
-    do {
-        // Draw the current page
-    } while (_display.nextPage());
+    const uint32_t idleTime = (uint32_t)(esp_timer_get_time() / 1000ULL) - _lastInputTime;
+    const PanelState state = idleTime >= OFF_TIMEOUT_MS ? PanelState::Off
+                           : idleTime >= DIM_TIMEOUT_MS ? PanelState::Dimmed
+                           : PanelState::On;
+    if (state != _panelState) {
+        setPanelState(state);
+    }
+    if (_framePending && _panelState != PanelState::Off && isFrameDue()) {
+        flush();
+    }
+}
+
+bool DisplayManager::wake() {
+    _lastInputTime = (uint32_t)(esp_timer_get_time() / 1000ULL);
+    const bool wasOff = _panelState == PanelState::Off;
+    if (_panelState != PanelState::On) {
+        setPanelState(PanelState::On);
+    }
+    // Frames drawn while the panel was off are committed by the next update()
+    return wasOff;
+}
+
+void DisplayManager::setPanelState(PanelState state) {
+    _panelState = state;
+    if (_frontLock) xSemaphoreTake(_frontLock, portMAX_DELAY);
+    _requestedPanelState = state;
+    if (_frontLock) xSemaphoreGive(_frontLock);
+
+    if (_flushTask) {
+        xTaskNotifyGive(_flushTask);
+    } else {
+        applyPanelState();
+    }
+}
+
+void DisplayManager::applyPanelState() {
+    if (_frontLock) xSemaphoreTake(_frontLock, portMAX_DELAY);
+    const PanelState requested = _requestedPanelState;
+    if (_frontLock) xSemaphoreGive(_frontLock);
+    if (requested == _appliedPanelState) {
+        return;
+    }
+
+    u8x8_t* u8x8 = _display.getU8x8();
+    if (requested == PanelState::Off) {
+        u8x8_SetPowerSave(u8x8, 1);
+    } else {
+        u8x8_SetContrast(u8x8, requested == PanelState::On ? ACTIVE_CONTRAST : DIMMED_CONTRAST);
+        if (_appliedPanelState == PanelState::Off) {
+            u8x8_SetPowerSave(u8x8, 0);
+        }
+    }
+    _appliedPanelState = requested;
+}
+
+bool DisplayManager::isFrameDue() const {
+    const uint32_t now = (uint32_t)(esp_timer_get_time() / 1000ULL);
+    return now - _lastFrameTime >= FRAME_INTERVAL_MS;
 }
 
 void DisplayManager::clear() {
-    _display.clear();
+    // Every caller redraws and sends right after clearing, so sending a blank frame here would be wasted
+    _display.clearBuffer();
+    _dirty.markAll();
+    onBufferCleared();
 }
 
 void DisplayManager::clearBuffer() {
     _display.clearBuffer();
+    _dirty.markAll();
+    onBufferCleared();
 }
 
 void DisplayManager::drawStr(uint8_t x, uint8_t y, const char* str) {
-    _display.drawUTF8(x, y, str);
+    markTextDirty(x, y, _display.drawUTF8(x, y, str));
 }
 
 void DisplayManager::drawBox(uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
     _display.drawBox(x, y, w, h);
+    _dirty.mark(x, y, w, h);
 }
 
 void DisplayManager::drawRBox(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t r) {
     _display.drawRBox(x, y, w, h, r);
+    _dirty.mark(x, y, w, h);
 }
 
 void DisplayManager::drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2) {
     _display.drawTriangle(x0, y0, x1, y1, x2, y2);
+    const int16_t minX = min(x0, min(x1, x2));
+    const int16_t minY = min(y0, min(y1, y2));
+    _dirty.mark(minX, minY, max(x0, max(x1, x2)) - minX + 1, max(y0, max(y1, y2)) - minY + 1);
 }
 
 void DisplayManager::setDrawColor(uint8_t color) {
+    _drawColor = color;
     _display.setDrawColor(color);
 }
 
@@ -70,23 +174,106 @@ uint8_t DisplayManager::getDisplayHeight() {
 }
 
 void DisplayManager::sendBuffer() {
-    _display.sendBuffer();
+    _framePending = true;
+}
+
+void DisplayManager::flush() {
+    if (_panelState == PanelState::Off) {
+        // Keep accumulating dirty tiles; wake() gets the frame committed
+        _framePending = true;
+        return;
+    }
+    _framePending = false;
+    _lastFrameTime = (uint32_t)(esp_timer_get_time() / 1000ULL);
+    if (_fullFlushOnly) {
+        _dirty.markAll();
+    }
+    const uint8_t* backBuffer = _display.getBufferPtr();
+    if (_frontLock) xSemaphoreTake(_frontLock, portMAX_DELAY);
+    // Copy the dirty spans to the front buffer and merge them with whatever the task has not sent yet
+    for (uint8_t row = 0; row < DirtyTiles::ROWS; row++) {
+        if (!_dirty.isRowDirty(row)) {
+            continue;
+        }
+        const uint8_t firstColumn = _dirty.firstColumn(row);
+        const uint8_t columnCount = _dirty.columnCount(row);
+        const uint16_t offset = row * ROW_BYTES + firstColumn * DirtyTiles::TILE_SIZE;
+        memcpy(_frontBuffer + offset, backBuffer + offset, columnCount * DirtyTiles::TILE_SIZE);
+        _pending.markColumns(row, firstColumn, firstColumn + columnCount - 1);
+    }
+    if (_frontLock) xSemaphoreGive(_frontLock);
+    _dirty.clear();
+
+    if (_flushTask) {
+        xTaskNotifyGive(_flushTask);
+    } else {
+        transferPendingRows();
+    }
+}
+
+void DisplayManager::transferPendingRows() {
+    uint8_t rowBuffer[ROW_BYTES];
+    for (uint8_t row = 0; row < DirtyTiles::ROWS; row++) {
+        // Only hold the lock while copying, so sendBuffer() never waits for the I2C bus
+        if (_frontLock) xSemaphoreTake(_frontLock, portMAX_DELAY);
+        const bool pending = _pending.isRowDirty(row);
+        const uint8_t firstColumn = _pending.firstColumn(row);
+        const uint8_t columnCount = _pending.columnCount(row);
+        if (pending) {
+            memcpy(rowBuffer, _frontBuffer + row * ROW_BYTES + firstColumn * DirtyTiles::TILE_SIZE, columnCount * DirtyTiles::TILE_SIZE);
+            _pending.clearRow(row);
+        }
+        if (_frontLock) xSemaphoreGive(_frontLock);
+
+        if (pending) {
+            u8x8_DrawTile(_display.getU8x8(), firstColumn, row, columnCount, rowBuffer);
+        }
+    }
+}
+
+void DisplayManager::flushTask(void* arg) {
+    DisplayManager* self = static_cast<DisplayManager*>(arg);
+    for (;;) {
+        // Several sendBuffer() calls made during a transfer collapse into a single wake-up
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        self->applyPanelState();
+        self->transferPendingRows();
+    }
 }
 
 void DisplayManager::setFont(const uint8_t* font) {
+    _font = font;
     _display.setFont(font);
 }
 
 void DisplayManager::drawUTF8(uint8_t x, uint8_t y, const char* str) {
-    _display.drawUTF8(x, y, str);
+    markTextDirty(x, y, _display.drawUTF8(x, y, str));
+}
+
+void DisplayManager::drawNumeric(uint8_t x, uint8_t y, const char* str) {
+    // Cached glyphs are OR-ed into the buffer, which only matches U8g2 when drawing in colour 1
+    if (_drawColor != 1 || !_glyphCache.contains(_font, str)) {
+        drawUTF8(x, y, str);
+        return;
+    }
+    markTextDirty(x, y, _glyphCache.draw(_display.getBufferPtr(), _font, x, y, str));
+}
+
+uint8_t DisplayManager::getNumericWidth(const char* str) {
+    if (!_glyphCache.contains(_font, str)) {
+        return _display.getUTF8Width(str);
+    }
+    return _glyphCache.getWidth(_font, str);
 }
 
 void DisplayManager::drawHLine(uint8_t x, uint8_t y, uint8_t w) {
     _display.drawHLine(x, y, w);
+    _dirty.mark(x, y, w, 1);
 }
 
 void DisplayManager::drawVLine(uint8_t x, uint8_t y, uint8_t h) {
     _display.drawVLine(x, y, h);
+    _dirty.mark(x, y, 1, h);
 }
 
 void DisplayManager::setFontMode(uint8_t mode) {
@@ -97,8 +284,24 @@ void DisplayManager::setBitmapMode(uint8_t mode) {
     _display.setBitmapMode(mode);
 }
 
+void DisplayManager::drawFrame(int16_t x, int16_t y, uint8_t w, uint8_t h) {
+    _display.drawFrame(x, y, w, h);
+    _dirty.mark(x, y, w, h);
+}
+
+void DisplayManager::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    _display.drawLine(x0, y0, x1, y1);
+    _dirty.mark(min(x0, x1), min(y0, y1), abs(x1 - x0) + 1, abs(y1 - y0) + 1);
+}
+
+void DisplayManager::drawPixel(int16_t x, int16_t y) {
+    _display.drawPixel(x, y);
+    _dirty.mark(x, y, 1, 1);
+}
+
 void DisplayManager::drawXBMP(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t* bitmap) {
     _display.drawXBMP(x, y, w, h, bitmap);
+    _dirty.mark(x, y, w, h);
 }
 
 void DisplayManager::setCursor(const uint8_t x, const uint8_t y) {
@@ -106,66 +309,13 @@ void DisplayManager::setCursor(const uint8_t x, const uint8_t y) {
 }
 
 void DisplayManager::print(const char* str) {
+    const u8g2_uint_t startX = _display.tx;
     _display.print(str);
+    markTextDirty(startX, _display.ty, _display.tx - startX);
 }
 
-uint8_t DisplayManager::drawTitle(const char* title, const uint8_t y) {
-    _display.setFont(u8g2_font_t0_11_tf);
-    _display.setDrawColor(1);
-    const uint8_t lineHeight = _display.getAscent() - _display.getDescent() + 2; // Line height (font height + spacing)
-    const uint8_t displayWidth = _display.getDisplayWidth(); // Get the display width
-
-    // Split the title into lines based on EOL or CR
-    char titleCopy[100]; // Copy the title to a mutable buffer
-    strncpy(titleCopy, title, sizeof(titleCopy));
-    titleCopy[sizeof(titleCopy) - 1] = '\0'; // Ensure null termination
-
-    char* line = strtok(titleCopy, "\n"); // Split the title into lines
-    uint8_t currentY = y; // Initial Y position for drawing
-
-    while (line != nullptr) {
-        // Draw the current line centered on the display
-        _display.drawUTF8((displayWidth - _display.getUTF8Width(line)) / 2, currentY, line);
-        currentY += lineHeight; // Move Y position down
-
-        // Get the next line
-        line = strtok(nullptr, "\n");
-    }
-    return currentY + lineHeight;
-}
-
-
-
-void DisplayManager::drawButtons(const char* buttonTexts[], uint8_t buttonCount, int8_t selectedButton) {
-    setFont(u8g2_font_t0_11_tf);
-    const uint8_t padding = 3;
-    const uint8_t screenHeight = getDisplayHeight();
-    const uint8_t screenWidth = getDisplayWidth();
-    const uint8_t buttonsY = screenHeight - padding;
-    const uint8_t buttonHeight = 13;
-    setDrawColor(0);
-    drawBox(0, screenHeight - buttonHeight, screenWidth, buttonHeight);
-    if (buttonCount == 1) {
-        const uint8_t sidePadding = 7;
-        uint8_t textWidth = getUTF8Width(buttonTexts[0]);
-        uint8_t buttonWidth = textWidth + 2 * sidePadding;
-        uint8_t buttonX = (screenWidth - buttonWidth) / 2;
-        setDrawColor(1);
-        drawUTF8(buttonX + sidePadding, buttonsY, buttonTexts[0]);
-        if (selectedButton == 0) {
-            setDrawColor(2);
-            drawRBox(buttonX, screenHeight - buttonHeight, buttonWidth, buttonHeight, 1);
-        }
-    } else {
-        uint8_t buttonAreaWidth = screenWidth / buttonCount;
-        for (uint8_t i = 0; i < buttonCount; ++i) {
-            setDrawColor(1);
-            uint8_t textWidth = getUTF8Width(buttonTexts[i]);
-            drawUTF8(i * buttonAreaWidth + (buttonAreaWidth - textWidth) / 2, buttonsY, buttonTexts[i]);
-            if (selectedButton == i) {
-                setDrawColor(2);
-                drawRBox(i * buttonAreaWidth, screenHeight - buttonHeight, buttonAreaWidth, buttonHeight, 1);
-            }
-        }
-    }
+void DisplayManager::markTextDirty(int16_t x, int16_t y, int16_t w) {
+    // The tallest glyph can rise above the reference ascent (e.g. accented capitals)
+    const int16_t top = y - _display.getMaxCharHeight();
+    _dirty.mark(x, top, w, y - _display.getDescent() - top);
 }
@@ -1,42 +1,113 @@
 #pragma once
 
 #include <U8g2lib.h>
-#include "IDisplayManager.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include "DisplayBase.h"
+#include "DirtyTiles.h"
+#include "GlyphCache.h"
 
-class DisplayManager : public IDisplayManager {
+// U8g2 backed display. Views bind to it directly through DisplayBackend, so none of these
+// calls are virtual.
+class DisplayManager final : public DisplayBase<DisplayManager> {
 public:
     DisplayManager(const u8g2_cb_t * rotation);
-    void begin() override;
-    void update() override;
-    void clear() override;
-    void drawStr(uint8_t x, uint8_t y, const char* str) override;
-    void drawBox(uint8_t x, uint8_t y, uint8_t w, uint8_t h) override;
-    void drawRBox(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t r) override;
-    void setDrawColor(uint8_t color) override;
-    uint8_t getStrWidth(const char* str) override;
-    uint8_t getUTF8Width(const char* str) override;
-    uint8_t getAscent() override;
-    uint8_t getDescent() override;
-    uint8_t getDisplayWidth() override;
-    uint8_t getDisplayHeight() override;
-    uint8_t getWidth() override;
-    void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2) override;
-    void sendBuffer() override;
-    void clearBuffer() override;
-    void setFont(const uint8_t* font) override;
-    void drawUTF8(uint8_t x, uint8_t y, const char* str) override;
-    void drawHLine(uint8_t x, uint8_t y, uint8_t w) override;
-    void drawVLine(uint8_t x, uint8_t y, uint8_t h) override;
-    void setFontMode(uint8_t mode) override;
-    void setBitmapMode(uint8_t mode) override;
-    void drawXBMP(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t* bitmap) override;
-
-    void setCursor(const uint8_t x, const uint8_t y) override;
-    void print(const char* str) override;
-
-    uint8_t drawTitle(const char* title, const uint8_t y = 10) override;
-    void drawButtons(const char* buttonTexts[], uint8_t buttonCount, int8_t selectedButton = -1) override;
-    U8G2* getDisplay() { return &_display; }
+    void begin();
+    // Commits the pending frame once the frame period has elapsed, and dims then switches the panel
+    // off after a while without input; call once per loop()
+    void update();
+    // Records user input and brings the panel back to full contrast. Returns true if the panel was
+    // off, in which case the input should only wake it
+    bool wake();
+    // True when a frame requested now would be committed by the next update()
+    bool isFrameDue() const;
+    // Clears the frame buffer; the blank frame is transferred on the next sendBuffer()
+    void clear();
+    void drawStr(uint8_t x, uint8_t y, const char* str);
+    void drawBox(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+    void drawRBox(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t r);
+    void drawFrame(int16_t x, int16_t y, uint8_t w, uint8_t h);
+    void drawPixel(int16_t x, int16_t y);
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+    void setDrawColor(uint8_t color);
+    uint8_t getStrWidth(const char* str);
+    uint8_t getUTF8Width(const char* str);
+    uint8_t getAscent();
+    uint8_t getDescent();
+    uint8_t getDisplayWidth();
+    uint8_t getDisplayHeight();
+    uint8_t getWidth();
+    void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2);
+    // Requests the buffer to be shown; requests made within one frame period coalesce into one transfer.
+    // Nothing is transferred while the panel is off, the frame is committed when it wakes up
+    void sendBuffer();
+    // Commits the buffer immediately, for code that blocks before the next update(). Hands the
+    // tile regions touched since the last commit over to the flush task and returns immediately;
+    // the I2C transfer happens in the background. Deferred until wake() while the panel is off
+    void flush();
+    void clearBuffer();
+    void setFont(const uint8_t* font);
+    void drawUTF8(uint8_t x, uint8_t y, const char* str);
+    // Numeric readouts (digits, '.', '-', ':', 'h', 'm', '°'), blitted from pre-decoded glyphs.
+    // Falls back to drawUTF8() for fonts or characters missing from the glyph cache
+    void drawNumeric(uint8_t x, uint8_t y, const char* str);
+    uint8_t getNumericWidth(const char* str);
+    void drawHLine(uint8_t x, uint8_t y, uint8_t w);
+    void drawVLine(uint8_t x, uint8_t y, uint8_t h);
+    void setFontMode(uint8_t mode);
+    void setBitmapMode(uint8_t mode);
+    void drawXBMP(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t* bitmap);
+
+    void setCursor(const uint8_t x, const uint8_t y);
+    void print(const char* str);
+
 private:
+    enum class PanelState : uint8_t {
+        On,
+        Dimmed,
+        Off
+    };
+
+    static constexpr uint16_t ROW_BYTES = DirtyTiles::COLUMNS * DirtyTiles::TILE_SIZE;
+    static constexpr uint32_t FLUSH_TASK_STACK_SIZE = 3072;
+    static constexpr UBaseType_t FLUSH_TASK_PRIORITY = 1; // Same as the Arduino loop task
+    // Caps the frame rate, and therefore the I2C bandwidth, regardless of how fast loop() spins
+    static constexpr uint8_t TARGET_FPS = 30;
+    static constexpr uint32_t FRAME_INTERVAL_MS = 1000 / TARGET_FPS;
+    // Idle policy: long runs would otherwise keep the OLED lit for hours, wearing the pixels
+    static constexpr uint32_t DIM_TIMEOUT_MS = 30 * 1000;
+    static constexpr uint32_t OFF_TIMEOUT_MS = 5 * 60 * 1000;
+    static constexpr uint8_t ACTIVE_CONTRAST = 0xCF; // U8g2's SH1106 power-on contrast
+    static constexpr uint8_t DIMMED_CONTRAST = 0x10;
+
+    // U8g2's own buffer is the back buffer views draw into
     U8G2_SH1106_128X64_NONAME_F_HW_I2C _display;
+    // Tile coordinates only match pixel coordinates when the display is not rotated
+    const bool _fullFlushOnly;
+    // Tiles touched since the last commit
+    DirtyTiles _dirty;
+    bool _framePending;
+    uint32_t _lastFrameTime;
+    // Current font and draw colour, so drawNumeric() knows when the glyph cache applies
+    const uint8_t* _font;
+    uint8_t _drawColor;
+    GlyphCache _glyphCache;
+    PanelState _panelState;
+    uint32_t _lastInputTime;
+
+    // Front buffer and the spans of it still waiting for the flush task, guarded by _frontLock.
+    // Panel state changes are I2C commands too, so they go through the task as well
+    uint8_t _frontBuffer[DirtyTiles::ROWS * ROW_BYTES];
+    DirtyTiles _pending;
+    PanelState _requestedPanelState;
+    PanelState _appliedPanelState;
+    SemaphoreHandle_t _frontLock;
+    TaskHandle_t _flushTask;
+
+    void markTextDirty(int16_t x, int16_t y, int16_t w);
+    void setPanelState(PanelState state);
+    void applyPanelState();
+    void transferPendingRows();
+    static void flushTask(void* arg);
 };
@@ -0,0 +1,8 @@
+#include "Fonts.h"
+#include "FontSubsets.h"
+
+namespace fonts {
+    const uint8_t* const REGULAR = subsets::REGULAR;
+    const uint8_t* const LARGE = subsets::LARGE;
+    const uint8_t* const MEDIUM = subsets::MEDIUM;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <stdint.h>
+
+// Fonts used by the UI. They point to subsets generated by tools/generate_font_subsets.py that
+// only hold the glyphs the UI can display, or to the full U8g2 fonts when U8g2 was not installed
+// yet at generation time.
+namespace fonts {
+    // u8g2_font_t0_11_tf: menus, titles and any dynamic text
+    extern const uint8_t* const REGULAR;
+    // u8g2_font_ncenB18_tf: numeric readouts only
+    extern const uint8_t* const LARGE;
+    // u8g2_font_ncenB12_tr: day offset of AdjustTimeView only
+    extern const uint8_t* const MEDIUM;
+}
@@ -0,0 +1,156 @@
+#include "GlyphCache.h"
+
+namespace {
+    // Slot order of the cached characters; the degree sign takes the last slot
+    constexpr char ASCII_GLYPHS[] = "0123456789.-:hm";
+    constexpr uint8_t DEGREE_SLOT = sizeof(ASCII_GLYPHS) - 1;
+    constexpr uint16_t DEGREE_ENCODING = 0xB0;
+}
+
+GlyphCache::GlyphCache() : _fontCount(0), _poolUsed(0) {}
+
+bool GlyphCache::add(u8g2_t* display, const uint8_t* font) {
+    if (find(font)) return true;
+    if (_fontCount >= MAX_FONTS) return false;
+
+    u8g2_SetFont(display, font);
+    u8g2_SetFontMode(display, 0);
+    u8g2_SetDrawColor(display, 1);
+    // Render with the tallest possible glyph fully on screen
+    const int16_t baseline = u8g2_GetMaxCharHeight(display);
+    const int16_t bottom = min<int16_t>(baseline - u8g2_GetDescent(display), BUFFER_HEIGHT);
+    const uint8_t* buffer = u8g2_GetBufferPtr(display);
+
+    FontEntry& entry = _fonts[_fontCount];
+    entry.font = font;
+
+    // First pass: measure every glyph and the ink rows shared by the whole set
+    int16_t inkTop = bottom;
+    int16_t inkBottom = -1;
+    for (uint8_t slot = 0; slot < GLYPH_COUNT; slot++) {
+        u8g2_ClearBuffer(display);
+        Glyph& glyph = entry.glyphs[slot];
+        glyph.advance = u8g2_DrawGlyph(display, 0, baseline, encodingForSlot(slot));
+        glyph.columns = 0;
+        for (uint8_t x = 0; x < BUFFER_WIDTH; x++) {
+            for (int16_t y = 0; y < bottom; y++) {
+                if (pixelAt(buffer, x, y)) {
+                    glyph.columns = x + 1;
+                    inkTop = min(inkTop, y);
+                    inkBottom = max(inkBottom, y);
+                }
+            }
+        }
+    }
+    if (inkBottom < inkTop) return false;
+    entry.top = inkTop - baseline;
+    entry.pages = (inkBottom - inkTop) / 8 + 1;
+
+    uint16_t needed = 0;
+    for (uint8_t slot = 0; slot < GLYPH_COUNT; slot++) {
+        needed += entry.glyphs[slot].columns * entry.pages;
+    }
+    if (_poolUsed + needed > POOL_SIZE) return false;
+
+    // Second pass: copy the ink rows, re-based so page 0 starts at inkTop
+    for (uint8_t slot = 0; slot < GLYPH_COUNT; slot++) {
+        u8g2_ClearBuffer(display);
+        u8g2_DrawGlyph(display, 0, baseline, encodingForSlot(slot));
+        Glyph& glyph = entry.glyphs[slot];
+        glyph.offset = _poolUsed;
+        for (uint8_t page = 0; page < entry.pages; page++) {
+            for (uint8_t x = 0; x < glyph.columns; x++) {
+                uint8_t bits = 0;
+                for (uint8_t bit = 0; bit < 8; bit++) {
+                    const int16_t y = inkTop + page * 8 + bit;
+                    if (y <= inkBottom && pixelAt(buffer, x, y)) {
+                        bits |= 1 << bit;
+                    }
+                }
+                _pool[_poolUsed++] = bits;
+            }
+        }
+    }
+    _fontCount++;
+    return true;
+}
+
+bool GlyphCache::contains(const uint8_t* font, const char* text) const {
+    if (!find(font)) return false;
+    while (*text) {
+        if (nextSlot(text) < 0) return false;
+    }
+    return true;
+}
+
+uint8_t GlyphCache::getWidth(const uint8_t* font, const char* text) const {
+    const FontEntry* entry = find(font);
+    if (!entry) return 0;
+    uint8_t width = 0;
+    while (*text) {
+        const int8_t slot = nextSlot(text);
+        if (slot >= 0) width += entry->glyphs[slot].advance;
+    }
+    return width;
+}
+
+uint8_t GlyphCache::draw(uint8_t* buffer, const uint8_t* font, int16_t x, int16_t y, const char* text) const {
+    const FontEntry* entry = find(font);
+    if (!entry) return 0;
+    const int16_t startX = x;
+    const int16_t top = y + entry->top;
+    // Offset by one screen height so negative rows still split into page and shift correctly
+    const uint8_t shift = (top + BUFFER_HEIGHT) % 8;
+    const int16_t firstPage = (top + BUFFER_HEIGHT) / 8 - BUFFER_HEIGHT / 8;
+    const int16_t pageCount = BUFFER_HEIGHT / 8;
+
+    while (*text) {
+        const int8_t slot = nextSlot(text);
+        if (slot < 0) continue;
+        const Glyph& glyph = entry->glyphs[slot];
+        for (uint8_t column = 0; column < glyph.columns; column++) {
+            const int16_t px = x + column;
+            if (px < 0 || px >= BUFFER_WIDTH) continue;
+            for (uint8_t page = 0; page < entry->pages; page++) {
+                const uint8_t bits = _pool[glyph.offset + page * glyph.columns + column];
+                if (!bits) continue;
+                const int16_t destPage = firstPage + page;
+                if (destPage >= 0 && destPage < pageCount) {
+                    buffer[destPage * BUFFER_WIDTH + px] |= bits << shift;
+                }
+                if (shift && destPage + 1 >= 0 && destPage + 1 < pageCount) {
+                    buffer[(destPage + 1) * BUFFER_WIDTH + px] |= bits >> (8 - shift);
+                }
+            }
+        }
+        x += glyph.advance;
+    }
+    return x - startX;
+}
+
+const GlyphCache::FontEntry* GlyphCache::find(const uint8_t* font) const {
+    for (uint8_t i = 0; i < _fontCount; i++) {
+        if (_fonts[i].font == font) return &_fonts[i];
+    }
+    return nullptr;
+}
+
+int8_t GlyphCache::nextSlot(const char*& text) {
+    const uint8_t c = static_cast<uint8_t>(*text++);
+    // The degree sign is the only multi-byte character, encoded as C2 B0 in UTF-8
+    if (c == 0xC2 && static_cast<uint8_t>(*text) == DEGREE_ENCODING) {
+        text++;
+        return DEGREE_SLOT;
+    }
+    const char* found = c ? strchr(ASCII_GLYPHS, c) : nullptr;
+    return found ? static_cast<int8_t>(found - ASCII_GLYPHS) : -1;
+}
+
+uint16_t GlyphCache::encodingForSlot(uint8_t slot) {
+    return slot == DEGREE_SLOT ? DEGREE_ENCODING : static_cast<uint8_t>(ASCII_GLYPHS[slot]);
+}
+
+bool GlyphCache::pixelAt(const uint8_t* buffer, uint8_t x, uint8_t y) {
+    // SH1106 buffers store 8 vertical pixels per byte, least significant bit on top
+    return buffer[(y / 8) * BUFFER_WIDTH + x] & (1 << (y % 8));
+}
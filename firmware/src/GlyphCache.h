@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+
+// Pre-decoded bitmaps of the characters used by numeric readouts (digits, '.', '-', ':', 'h', 'm'
+// and '°'). Glyphs are stored in the SH1106 page layout so they can be OR-ed straight into the
+// frame buffer, skipping the U8g2 font decoder and string width measurement.
+class GlyphCache {
+public:
+    GlyphCache();
+
+    // Decode the cached characters of font by rendering them through display.
+    // Clobbers the frame buffer, font and draw colour; the caller restores them afterwards.
+    bool add(u8g2_t* display, const uint8_t* font);
+
+    // True if every character of text is cached for font
+    bool contains(const uint8_t* font, const char* text) const;
+
+    // Sum of the glyph advances of text (text must be fully cached)
+    uint8_t getWidth(const uint8_t* font, const char* text) const;
+
+    // Blit text with its baseline at y into a 128 pixel wide page buffer; returns the width drawn
+    uint8_t draw(uint8_t* buffer, const uint8_t* font, int16_t x, int16_t y, const char* text) const;
+
+private:
+    static constexpr uint8_t MAX_FONTS = 2;
+    static constexpr uint8_t GLYPH_COUNT = 16;
+    static constexpr uint16_t POOL_SIZE = 1536;
+    static constexpr uint8_t BUFFER_WIDTH = 128;
+    static constexpr uint8_t BUFFER_HEIGHT = 64;
+
+    struct Glyph {
+        uint16_t offset;  // Start of the glyph columns in _pool, one byte per column and page
+        uint8_t columns;  // Columns holding ink
+        uint8_t advance;  // Distance to the next glyph origin
+    };
+
+    struct FontEntry {
+        const uint8_t* font;
+        int8_t top;       // First ink row, relative to the baseline
+        uint8_t pages;    // 8-pixel pages needed to hold the tallest glyph
+        Glyph glyphs[GLYPH_COUNT];
+    };
+
+    FontEntry _fonts[MAX_FONTS];
+    uint8_t _fontCount;
+    uint8_t _pool[POOL_SIZE];
+    uint16_t _poolUsed;
+
+    const FontEntry* find(const uint8_t* font) const;
+    static int8_t nextSlot(const char*& text);
+    static uint16_t encodingForSlot(uint8_t slot);
+    static bool pixelAt(const uint8_t* buffer, uint8_t x, uint8_t y);
+};
@@ -1,29 +1,44 @@
 #include "Graph.h"
 
+// Indexed at runtime, so defined here too as C++11 requires
+constexpr uint8_t Graph::LEVEL_RATIOS[];
+
+void Graph::configure(const int w, const int h, bool drawAxes) {
+    configure(w, h, MIN_VALUE, MAX_VALUE, drawAxes);
+    _autoBounds = true;
+}
+
 void Graph::configure(const int w, const int h, const float minValue, const float maxValue, bool drawAxes) {
     _width = min(w, MAX_GRAPH_WIDTH);
     _height = min(h, MAX_GRAPH_HEIGHT);
-    _minValue = minValue;
-    _maxValue = maxValue;
-    _currentIndex = 0;
+    _autoBounds = false;
+    _minPoint = toPoint(minValue);
+    _maxPoint = toPoint(maxValue);
     _drawAxes = drawAxes;
-    
-    // Initialize values array with invalid temperature marker
-    for (uint8_t i = 0; i < MAX_GRAPH_WIDTH; i++) {
-        _values[i] = -274.0f;
-    }
+    clear();
 }
 
-void Graph::addValueToAverage(const float value) {
+void Graph::addValueToAverage(const float value, const uint8_t channels) {
     _sumForAverage += value;
     _countForAverage++;
+    for (uint8_t channel = 0; channel < CHANNEL_COUNT; channel++) {
+        if (channels & (1 << channel)) {
+            _channelCountsForAverage[channel]++;
+        }
+    }
 }
 
 void Graph::commitAverage(const float defaultValue) {
     // If no values were added, use the default value
     if (_countForAverage > 0) {
         const float average = _sumForAverage / _countForAverage;
-        addPoint(average);
+        uint8_t channels = 0;
+        for (uint8_t channel = 0; channel < CHANNEL_COUNT; channel++) {
+            if (_channelCountsForAverage[channel] * 2 >= _countForAverage) {
+                channels |= 1 << channel;
+            }
+        }
+        addPoint(average, channels);
     }
     else {
         addPoint(defaultValue);
@@ -31,14 +46,153 @@ void Graph::commitAverage(const float defaultValue) {
     // Reset averaging
     _sumForAverage = 0;
     _countForAverage = 0;
+    memset(_channelCountsForAverage, 0, sizeof(_channelCountsForAverage));
+}
+
+void Graph::addPoint(float value, const uint8_t channels) {
+    _totalPoints++;
+    pushPoint(0, isnan(value) ? INVALID_POINT : toPoint(value), channels);
+}
+
+int16_t Graph::toPoint(const float value) {
+    return lroundf(constrain(value, MIN_VALUE, MAX_VALUE) / STEP);
+}
+
+void Graph::pushPoint(const uint8_t level, const int16_t point, const uint8_t channels) {
+    Level& history = _levels[level];
+    const uint8_t block = history.sequence / BLOCK_SIZE;
+    if (history.sequence % BLOCK_SIZE == 0) {
+        history.basesSet &= ~(1 << block);
+    }
+    int8_t offset = INVALID_OFFSET;
+    if (point != INVALID_POINT) {
+        if (!(history.basesSet & (1 << block))) {
+            history.bases[block] = point;
+            history.basesSet |= 1 << block;
+        }
+        const int16_t step = BASE_STEP << level;
+        const int32_t difference = point - history.bases[block];
+        const int32_t steps = (difference + (difference >= 0 ? step / 2 : -(step / 2))) / step;
+        offset = constrain(steps, INVALID_OFFSET + 1, INT8_MAX);
+    }
+    history.points[history.currentIndex] = offset;
+    history.sequence = (history.sequence + 1) % SEQUENCE_COUNT;
+    for (uint8_t channel = 0; channel < CHANNEL_COUNT; channel++) {
+        const uint8_t mask = 1 << (history.currentIndex % 8);
+        uint8_t& bits = history.channels[channel][history.currentIndex / 8];
+        bits = (channels & (1 << channel)) ? (bits | mask) : (bits & ~mask);
+    }
+    history.currentIndex = (history.currentIndex + 1) % MAX_GRAPH_WIDTH;
+    if (history.count < MAX_GRAPH_WIDTH) {
+        history.count++;
+    }
+    if (level == 0) {
+        const uint8_t sequence = (history.sequence + SEQUENCE_COUNT - 1) % SEQUENCE_COUNT;
+        trackExtremes(_minQueue, sequence, false);
+        trackExtremes(_maxQueue, sequence, true);
+    }
+    if (level + 1 >= LEVEL_COUNT) {
+        return;
+    }
+
+    // Feed the next level, which gets the rounded average of the valid points once its bucket is
+    // full, and the channels on for at least half of them
+    Level& next = _levels[level + 1];
+    if (point != INVALID_POINT) {
+        next.bucketSum += point;
+        next.bucketValid++;
+    }
+    for (uint8_t channel = 0; channel < CHANNEL_COUNT; channel++) {
+        if (channels & (1 << channel)) {
+            next.bucketChannels[channel]++;
+        }
+    }
+    if (++next.bucketSize < LEVEL_RATIOS[level + 1]) {
+        return;
+    }
+    int16_t average = INVALID_POINT;
+    if (next.bucketValid > 0) {
+        const int32_t halfCount = next.bucketSum >= 0 ? next.bucketValid / 2 : -(next.bucketValid / 2);
+        average = (next.bucketSum + halfCount) / next.bucketValid;
+    }
+    uint8_t bucketChannels = 0;
+    for (uint8_t channel = 0; channel < CHANNEL_COUNT; channel++) {
+        if (next.bucketChannels[channel] * 2 >= next.bucketSize) {
+            bucketChannels |= 1 << channel;
+        }
+        next.bucketChannels[channel] = 0;
+    }
+    next.bucketSum = 0;
+    next.bucketValid = 0;
+    next.bucketSize = 0;
+    pushPoint(level + 1, average, bucketChannels);
+}
+
+int16_t Graph::pointAt(const uint8_t level, const uint8_t age) const {
+    const Level& history = _levels[level];
+    const int8_t offset = history.points[indexOf(history, age)];
+    if (offset == INVALID_OFFSET) {
+        return INVALID_POINT;
+    }
+    const uint8_t sequence = (history.sequence + SEQUENCE_COUNT - 1 - age) % SEQUENCE_COUNT;
+    return history.bases[sequence / BLOCK_SIZE] + offset * (BASE_STEP << level);
+}
+
+void Graph::trackExtremes(ExtremeQueue& queue, const uint8_t sequence, const bool maximum) {
+    // Drop the points that left the window, which ends with the new point
+    while (queue.size > 0 && (sequence + SEQUENCE_COUNT - queue.sequences[queue.head]) % SEQUENCE_COUNT >= _width) {
+        queue.head = (queue.head + 1) % MAX_GRAPH_WIDTH;
+        queue.size--;
+    }
+    const int16_t point = pointBySequence(sequence);
+    if (point == INVALID_POINT) {
+        return;
+    }
+    // Older points that do not beat the new one can never be the extreme again
+    while (queue.size > 0) {
+        const int16_t last = pointBySequence(queue.sequences[(queue.head + queue.size - 1) % MAX_GRAPH_WIDTH]);
+        if (maximum ? last > point : last < point) {
+            break;
+        }
+        queue.size--;
+    }
+    queue.sequences[(queue.head + queue.size) % MAX_GRAPH_WIDTH] = sequence;
+    queue.size++;
+}
+
+uint16_t Graph::getLevelScale(const uint8_t level) {
+    uint16_t scale = 1;
+    for (uint8_t i = 1; i <= level; i++) {
+        scale *= LEVEL_RATIOS[i];
+    }
+    return scale;
+}
+
+uint8_t Graph::getLevelFor(const uint8_t width) const {
+    uint8_t level = 0;
+    while (level + 1 < LEVEL_COUNT && _totalPoints / getLevelScale(level) > width) {
+        level++;
+    }
+    return level;
+}
+
+float Graph::getPoint(const uint8_t level, const uint8_t age) const {
+    return pointAt(level, age) * STEP;
 }
 
-void Graph::addPoint(float value) {
-    _values[_currentIndex] = value;
-    _currentIndex = (_currentIndex + 1) % _width;
+uint8_t Graph::getChannels(const uint8_t level, const uint8_t age) const {
+    const Level& history = _levels[level];
+    const uint8_t index = indexOf(history, age);
+    uint8_t channels = 0;
+    for (uint8_t channel = 0; channel < CHANNEL_COUNT; channel++) {
+        if (history.channels[channel][index / 8] & (1 << (index % 8))) {
+            channels |= 1 << channel;
+        }
+    }
+    return channels;
 }
 
-void Graph::draw(U8G2* display, const uint8_t xPos, uint8_t yPos) {
+void Graph::draw(DisplayBackend* display, const uint8_t xPos, uint8_t yPos) {
     // Clear the graph area
     display->setDrawColor(0);
     display->drawBox(xPos, yPos, _width, _height);
@@ -51,25 +205,72 @@ void Graph::draw(U8G2* display, const uint8_t xPos, uint8_t yPos) {
         usableHeight -= 2; // Adjust height for axes
         yPos++; // Offset by 1 to account for top border
     }
+    // The channel strip takes the bottom rows, the curve the ones above
+    const uint8_t stripY = yPos + usableHeight - STRIP_HEIGHT;
+    usableHeight -= STRIP_HEIGHT + STRIP_GAP;
+
+    // Vertical bounds, in points, so points map to rows without going back to floats
+    const uint8_t pointCount = min(_levels[0].count, _width);
+    int16_t minPoint = _minPoint;
+    int16_t maxPoint = _maxPoint;
+    if (_autoBounds) {
+        if (_minQueue.size > 0) {
+            minPoint = pointBySequence(_minQueue.sequences[_minQueue.head]);
+            maxPoint = pointBySequence(_maxQueue.sequences[_maxQueue.head]);
+        }
+        const int16_t minSpan = lroundf(MIN_AUTO_SPAN / STEP);
+        if (maxPoint - minPoint < minSpan) {
+            minPoint -= (minSpan - (maxPoint - minPoint)) / 2;
+            maxPoint = minPoint + minSpan;
+        }
+    }
 
-    // Draw data points
-    for (uint8_t x = 0; x < _width; x++) {
-        const uint8_t idx = (_currentIndex + x) % _width;
-        const float val = _values[idx];
-        if (val < -273.0) continue; // Skip invalid values
-        const uint8_t y = yPos + usableHeight - 1 - static_cast<uint8_t>((val - _minValue) / (_maxValue - _minValue) * (usableHeight - 1));
+    // Draw the latest points, oldest on the left, joined by lines
+    int16_t previousY = -1;
+    for (uint8_t x = _width - pointCount; x < _width; x++) {
+        const int16_t point = pointAt(0, _width - 1 - x);
+        if (point == INVALID_POINT) {
+            previousY = -1;
+            continue;
+        }
+        const int16_t clamped = constrain(point, minPoint, maxPoint);
+        const int16_t y = yPos + usableHeight - 1 - (clamped - minPoint) * (usableHeight - 1) / (maxPoint - minPoint);
+        if (previousY < 0) {
+            display->drawPixel(xPos + x, y);
+        } else {
+            display->drawLine(xPos + x - 1, previousY, xPos + x, y);
+        }
+        previousY = y;
+    }
 
-        // Draw point
-        display->drawPixel(xPos + x, y);
+    // Runs of points with any channel on, one box each
+    uint8_t runStart = 0;
+    bool inRun = false;
+    for (uint8_t x = _width - pointCount; x <= _width; x++) {
+        const bool on = x < _width && getChannels(0, _width - 1 - x) != 0;
+        if (on && !inRun) {
+            runStart = x;
+        } else if (!on && inRun) {
+            display->drawBox(xPos + runStart, stripY, x - runStart, STRIP_HEIGHT);
+        }
+        inRun = on;
     }
 }
 
+void Graph::drawHighlight(DisplayBackend* display, const uint8_t xPos, const uint8_t yPos) const {
+    display->setDrawColor(2);
+    display->drawBox(xPos, yPos, _width, _height);
+    display->setDrawColor(1);
+}
+
 void Graph::clear() {
-    // Initialize _values array with invalid temperature marker
-    for (uint8_t i = 0; i < MAX_GRAPH_WIDTH; i++) {
-        _values[i] = -274.0f;
-    }
-    _currentIndex = 0;
+    _totalPoints = 0;
+    memset(_levels, 0, sizeof(_levels));
+    _minQueue.head = 0;
+    _minQueue.size = 0;
+    _maxQueue.head = 0;
+    _maxQueue.size = 0;
     _sumForAverage = 0;
     _countForAverage = 0;
+    memset(_channelCountsForAverage, 0, sizeof(_channelCountsForAverage));
 }
\ No newline at end of file
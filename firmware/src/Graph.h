@@ -1,6 +1,6 @@
 #pragma once
 #include <Arduino.h>
-#include <U8g2lib.h>
+#include "DisplayBackend.h"
 
 // Maximum dimensions for the entire application
 #define MAX_GRAPH_WIDTH  128
@@ -8,32 +8,133 @@
 
 class Graph {
 public:
-    // Configure graph for current use
+    // On/off channels recorded along with each point, one bit per point each, drawn as a strip
+    // under the curve
+    enum Channel : uint8_t {
+        HEATER = 1 << 0,
+        COOLER = 1 << 1
+    };
+    static constexpr uint8_t CHANNEL_COUNT = 2;
+
+    // Values the graph can hold; anything outside is clamped to them
+    static constexpr float MIN_VALUE = -5.0f;
+    static constexpr float MAX_VALUE = 60.0f;
+
+    // Configure graph for current use, its vertical bounds following the points drawn
+    void configure(const int width, const int height, bool drawAxes = false);
+    // Same, with fixed vertical bounds
     void configure(const int width, const int height, const float minValue, const float maxValue, bool drawAxes = false);
 
-    // Add a value to be averaged
-    void addValueToAverage(const float value);
+    // Add a value to be averaged, with the channels on at the time
+    void addValueToAverage(const float value, const uint8_t channels = 0);
 
-    // Calculate average and add it as a point
+    // Calculate average and add it as a point; a channel is on for the point if it was on for at
+    // least half of the values
     void commitAverage(const float defaultValue);
 
     // Add a data point directly (no averaging)
-    void addPoint(const float value);
+    void addPoint(const float value, const uint8_t channels = 0);
+
+    // Draw the latest points, as many as fit in the width, one per pixel
+    void draw(DisplayBackend* display, const uint8_t xPos, uint8_t yPos);
 
-    // Draw the graph
-    void draw(U8G2* display, const uint8_t xPos, uint8_t yPos);
+    // Invert the graph area, to show it is selected; drawing it again undoes it
+    void drawHighlight(DisplayBackend* display, const uint8_t xPos, const uint8_t yPos) const;
 
     // Clear the graph
     void clear();
 
+    // Current dimensions, in pixels
+    uint8_t getWidth() const { return _width; }
+    uint8_t getHeight() const { return _height; }
+
+    // History pyramid: level 0 keeps the latest MAX_GRAPH_WIDTH points, and each further level
+    // keeps as many averages of the level below, so the whole session fits in constant memory.
+    // Points of level 0 per point of a level
+    static uint16_t getLevelScale(const uint8_t level);
+    // Finest level whose completed points all fit in width points
+    uint8_t getLevelFor(const uint8_t width) const;
+    uint8_t getPointCount(const uint8_t level = 0) const { return _levels[level].count; }
+    uint32_t getTotalPoints() const { return _totalPoints; }
+    // False for points that could not be measured (NaN)
+    bool isPointValid(const uint8_t level, const uint8_t age) const { return pointAt(level, age) != INVALID_POINT; }
+    // Point added age points before the latest one (age 0), to the step of its level
+    float getPoint(const uint8_t level, const uint8_t age) const;
+    // Channels on for that point
+    uint8_t getChannels(const uint8_t level, const uint8_t age) const;
+
+    static constexpr uint8_t LEVEL_COUNT = 4;
+
 private:
-    uint8_t _width, _height;        // Current dimensions
-    bool _drawAxes;                 // Draw axis or not
-    float _minValue, _maxValue;     // Value range
-    uint8_t _currentIndex;          // Current position in circular buffer
-    float _values[MAX_GRAPH_WIDTH]; // Circular buffer for values
+    // Points are handled in hundredths of a degree, over the whole value range a cooling session
+    // can span
+    static constexpr int16_t INVALID_POINT = INT16_MIN;
+    static constexpr float STEP = 0.01f;
+    // They are stored as one byte offsets from the first valid point of their block, in steps of
+    // BASE_STEP hundredths on level 0: fine enough for the zoomed chart to show how closely the
+    // temperature is regulated. Steps double on each further level, whose blocks span more time,
+    // and offsets out of reach are clamped.
+    static constexpr int8_t INVALID_OFFSET = INT8_MIN;
+    static constexpr uint8_t BASE_STEP = 5;
+    static constexpr uint8_t BLOCK_SIZE = 32;
+    // One block more than the buffer holds, so the block being written never shares its base with
+    // the oldest points, not yet overwritten
+    static constexpr uint8_t BLOCK_COUNT = MAX_GRAPH_WIDTH / BLOCK_SIZE + 1;
+    static constexpr uint8_t SEQUENCE_COUNT = BLOCK_COUNT * BLOCK_SIZE;
+    // Smallest span of automatic bounds, so sensor noise is not blown up to the full height
+    static constexpr float MIN_AUTO_SPAN = 2.0f;
+    // Rows of the channel strip, and of the gap above it
+    static constexpr uint8_t STRIP_HEIGHT = 1;
+    static constexpr uint8_t STRIP_GAP = 1;
+    // Points of the level below averaged into one point of each level; with a point every 10s,
+    // the levels hold 10s, 1min, 10min and 1h points
+    static constexpr uint8_t LEVEL_RATIOS[LEVEL_COUNT] = {1, 6, 10, 6};
+
+    struct Level {
+        int8_t points[MAX_GRAPH_WIDTH]; // Circular buffer for offsets
+        int16_t bases[BLOCK_COUNT];     // Point each offset of a block is relative to
+        uint8_t channels[CHANNEL_COUNT][MAX_GRAPH_WIDTH / 8]; // Bitsets in step with points
+        uint8_t currentIndex;           // Current position in circular buffer
+        uint8_t count;                  // Points in the circular buffer
+        uint8_t sequence;               // Sequence number of the next point, modulo SEQUENCE_COUNT
+        uint8_t basesSet;               // Bitset of the blocks whose base is set
+        // Points of the level below averaged into the next point
+        int32_t bucketSum;
+        uint8_t bucketValid;
+        uint8_t bucketSize;
+        uint8_t bucketChannels[CHANNEL_COUNT];
+    };
+
+    uint8_t _width, _height;         // Current dimensions
+    bool _drawAxes;                  // Draw axis or not
+    bool _autoBounds;                // Vertical bounds follow the points drawn
+    int16_t _minPoint, _maxPoint;    // Fixed vertical bounds
+    uint32_t _totalPoints;           // Points added since the graph was cleared
+    Level _levels[LEVEL_COUNT];
+
+    // Extremes of the points draw() shows, the last _width points of level 0, as monotonic queues
+    // of sequence numbers: the points of the window that no later point beats, so the extreme is
+    // always at the front
+    struct ExtremeQueue {
+        uint8_t sequences[MAX_GRAPH_WIDTH];
+        uint8_t head;
+        uint8_t size;
+    };
+    ExtremeQueue _minQueue, _maxQueue;
+
+    void pushPoint(const uint8_t level, const int16_t point, const uint8_t channels);
+    static int16_t toPoint(const float value);
+    static uint8_t indexOf(const Level& history, const uint8_t age) {
+        return (history.currentIndex + MAX_GRAPH_WIDTH - 1 - age) % MAX_GRAPH_WIDTH;
+    }
+    int16_t pointAt(const uint8_t level, const uint8_t age) const;
+    int16_t pointBySequence(const uint8_t sequence) const {
+        return pointAt(0, (_levels[0].sequence + SEQUENCE_COUNT - 1 - sequence) % SEQUENCE_COUNT);
+    }
+    void trackExtremes(ExtremeQueue& queue, const uint8_t sequence, const bool maximum);
 
     // Averaging support
     float _sumForAverage;
     uint16_t _countForAverage;
+    uint16_t _channelCountsForAverage[CHANNEL_COUNT];
 };
\ No newline at end of file
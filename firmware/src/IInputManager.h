@@ -18,6 +18,10 @@ public:
     virtual bool isButtonPressed() = 0;
     virtual EncoderDirection getEncoderDirection() = 0;
     virtual int getPendingSteps() const = 0;
+    // True once after any encoder step or button press since the last call
+    virtual bool hasActivity() = 0;
+    // Drops the steps and button press not read yet
+    virtual void discardPendingInput() = 0;
     virtual void slowTemperaturePolling(bool slowPolling) = 0;
     virtual float getTemperature() const = 0;
 };
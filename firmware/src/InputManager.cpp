@@ -5,7 +5,7 @@
 
 InputManager::InputManager(const gpio_num_t clkPin, gpio_num_t dtPin, gpio_num_t swPin, gpio_num_t ds18b20Pin) :
         _encoder(clkPin, dtPin, RotaryEncoder::LatchMode::FOUR3), _encoderClk(clkPin),
-        _encoderDt(dtPin), _encoderSWPin(swPin), _buttonPressed(false),
+        _encoderDt(dtPin), _encoderSWPin(swPin), _buttonPressed(false), _activity(false),
         _lastButtonState(1), _buttonState(1), _lastDebounceTime(0), _ds18b20Manager(ds18b20Pin),
         _initialized(false), _lastEncoderPosition(0), _pendingSteps(0), _buttonIrq(false), _lastRawButtonReading(1)
 {
@@ -55,6 +55,7 @@ void InputManager::update() {
         // accumulate steps; positive for CW, negative for CCW
         _pendingSteps += (int)delta;
         _lastEncoderPosition = pos;
+        _activity = true;
     }
 
     // Handle button press with ISR edge gating and debounce
@@ -67,6 +68,7 @@ void InputManager::update() {
             _buttonState = _lastRawButtonReading;
             if (_buttonState == 0) {
                 _buttonPressed = true;
+                _activity = true;
             }
         }
         _lastButtonState = _lastRawButtonReading;
@@ -104,6 +106,17 @@ void IRAM_ATTR InputManager::isrButton(void* arg) {
     self->_buttonIrq = true;
 }
 
+bool InputManager::hasActivity() {
+    const bool activity = _activity;
+    _activity = false;
+    return activity;
+}
+
+void InputManager::discardPendingInput() {
+    resetEncoderPosition();
+    _buttonPressed = false;
+}
+
 bool InputManager::isButtonPressed() {
     if (_buttonPressed) {
         _buttonPressed = false; // Clear the flag
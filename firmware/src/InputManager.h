@@ -15,6 +15,8 @@ public:
     bool isButtonPressed() override;
     IInputManager::EncoderDirection getEncoderDirection() override;
     int getPendingSteps() const override;
+    bool hasActivity() override;
+    void discardPendingInput() override;
     void slowTemperaturePolling(bool slowPolling) override;
     float getTemperature() const override;
 
@@ -36,6 +38,7 @@ private:
     long _lastEncoderPosition;
     int _pendingSteps;
     bool _buttonPressed;
+    bool _activity;
     const unsigned long _debounceDelay = 50;
     static void isrButton(void* arg);
 };
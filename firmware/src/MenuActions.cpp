@@ -3,9 +3,11 @@
 #include "DebugUtils.h"
 #include "screens/controllers/AdjustTimeController.h"
 #include "screens/Menu.h"
+#include "MenuItems.h"
 #include "Timezones.h"
 #include "TimezoneHelpers.h"
 #include "StorageConstants.h"
+#include "services/INetworkService.h"
 
 // Static member definitions
 SimpleTime MenuActions::s_proofInTime(0, 0, 0);
@@ -50,13 +52,23 @@ void MenuActions::proofAtAction() {
     if (!_ctx || !_ctx->screens || !_adjustTimeController || !_coolingController) return;
     BaseController* menu = _ctx->screens->getActiveScreen();
     if (!menu) return;
+    // A time of day means nothing until NTP, or the time kept through a reset, has set the clock:
+    // a proof scheduled on the time restored after a power cut would start late by the outage.
+    // Stay in the menu until then.
+    services::INetworkService* network = _ctx->networkService;
+    if (!network || !network->isTimeReliable()) {
+        DEBUG_PRINTLN("Time not synchronized yet");
+        if (_menu) {
+            _menu->showMessage(network && network->isTimeKnown() ? "Heure \xC3\xA0 confirmer" : "Heure inconnue");
+        }
+        menu->setNextScreen(menu);
+        return;
+    }
     menu->setNextScreen(_adjustTimeController);
+    const time_t now = time(nullptr);
     struct tm timeinfo;
+    localtime_r(&now, &timeinfo);
     SimpleTime startTime(0, 0, 0);
-    if (!getLocalTime(&timeinfo)) {
-        DEBUG_PRINTLN("Failed to obtain time, defaulting to 0:00");
-        _adjustTimeController->prepare("Pousser \xC3\xA0...", _coolingController, menu, startTime, TimeMode::ProofAt);
-    }
     startTime.hours = timeinfo.tm_hour;
     startTime.minutes = timeinfo.tm_min;
     
@@ -135,9 +147,7 @@ void MenuActions::showDataDisplay() {
 // Static callback functions for time calculations
 time_t MenuActions::calculateProofInEndTime() {
     // Convert stored time to seconds delay from now
-    struct tm now;
-    getLocalTime(&now);
-    time_t nowTime = mktime(&now);
+    time_t nowTime = time(nullptr);
     time_t delayInSeconds =
         s_proofInTime.days * 86400 +
         s_proofInTime.hours * 3600 +
@@ -147,8 +157,9 @@ time_t MenuActions::calculateProofInEndTime() {
 
 time_t MenuActions::calculateProofAtEndTime() {
     // Convert stored time to target time_t
+    const time_t now = time(nullptr);
     struct tm targetTime;
-    getLocalTime(&targetTime);
+    localtime_r(&now, &targetTime);
 
     targetTime.tm_mday += s_proofAtTime.days;
     targetTime.tm_hour = s_proofAtTime.hours;
@@ -158,13 +169,6 @@ time_t MenuActions::calculateProofAtEndTime() {
     return mktime(&targetTime);
 }
 
-void MenuActions::saveTimezone(const char* posixString) {
-    if (!_ctx || !_ctx->storage) return;
-    _ctx->storage->setCharArray(storage::keys::TIMEZONE_KEY, posixString);
-    DEBUG_PRINT("Timezone saved: ");
-    DEBUG_PRINTLN(posixString);
-}
-
 // Generic timezone selection handler - uses Menu context to determine which timezone was selected
 void MenuActions::selectTimezoneByData() {
     if (!_menu) {
@@ -173,34 +177,23 @@ void MenuActions::selectTimezoneByData() {
     }
     
     // Get the current menu and selected index
-    Menu::MenuItem* currentMenu = _menu->getCurrentMenu();
-    uint8_t selectedIndex = _menu->getCurrentMenuIndex();
+    const Menu::MenuList* currentMenu = _menu->getCurrentMenu();
+    uint16_t selectedIndex = _menu->getCurrentMenuIndex();
     
     if (!currentMenu) {
         DEBUG_PRINTLN("Invalid menu context");
         return;
     }
     
-    // Find which continent menu we're in by matching the pointer
-    extern Menu::MenuItem* timezoneMenu;
-    
-    int continentIndex = -1;
-    int continentCount = timezones::getContinentCount();
-    
-    for (int c = 0; c < continentCount; c++) {
-        if (timezoneMenu && timezoneMenu[c].subMenu == currentMenu) {
-            continentIndex = c;
-            break;
-        }
-    }
-    
-    if (continentIndex < 0) {
+    // The continent of the timezone list menu we're in
+    const TimezoneMenuList* timezoneList = TimezoneMenuList::fromMenu(currentMenu);
+    if (!timezoneList) {
         DEBUG_PRINTLN("Could not determine continent from menu context");
         return;
     }
+    const int continentIndex = timezoneList->getContinentIndex();
     
-    const char* continentName = timezones::getContinentName(continentIndex);
-    int tzCount = timezones::getTimezoneCount(continentName);
+    int tzCount = timezones::getTimezoneCount(continentIndex);
     
     // The last item is "Retour", so if we selected it, don't do anything
     if (selectedIndex >= tzCount) {
@@ -212,13 +205,13 @@ void MenuActions::selectTimezoneByData() {
         return;
     }
     
-    const timezones::Timezone* tz = timezones::getTimezone(continentName, selectedIndex);
+    const timezones::Timezone* tz = timezones::getTimezone(continentIndex, selectedIndex);
     if (!tz) {
         DEBUG_PRINTLN("Could not get timezone");
         return;
     }
     
-    _confirmTimezoneController->setTimezoneInfo(continentName, tz->name, tz->posixString);
+    _confirmTimezoneController->setTimezoneInfo(tz - timezones::TIMEZONES);
     
     BaseController* currentScreen = _ctx->screens->getActiveScreen();
     if (currentScreen) {
@@ -56,9 +56,6 @@ private:
     PowerOffController* _powerOffController;
     DataDisplayController* _dataDisplayController;
     ConfirmTimezoneController* _confirmTimezoneController;
-    
-    // Helper function to save timezone
-    void saveTimezone(const char* posixString);
 };
 
 #endif
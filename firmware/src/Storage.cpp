@@ -1,6 +1,8 @@
 #include "DebugUtils.h"
 #include "Storage.h"
 #include "StorageConstants.h"
+#include "Timezones.h"
+#include "TimezoneHelpers.h"
 
 bool Storage::_initialized = false;
 static Preferences preferences;
@@ -20,7 +22,7 @@ bool Storage::begin() {
     InitKeyIfMissing(storage::keys::HOT_UPPER_LIMIT_KEY, storage::defaults::HOT_UPPER_LIMIT_DEFAULT);
     InitKeyIfMissing(storage::keys::COLD_LOWER_LIMIT_KEY, storage::defaults::COLD_LOWER_LIMIT_DEFAULT);
     InitKeyIfMissing(storage::keys::COLD_UPPER_LIMIT_KEY, storage::defaults::COLD_UPPER_LIMIT_DEFAULT);
-    InitKeyIfMissing(storage::keys::TIMEZONE_KEY, storage::defaults::TIMEZONE_DEFAULT);
+    MigrateTimezone();
 
     DEBUG_PRINTLN("Preferences initialized successfully");
     _initialized = true;
@@ -132,6 +134,26 @@ bool Storage::setCharArray(const char* path, const char* value) {
     }
 }
 
+void Storage::MigrateTimezone() {
+    if (preferences.isKey(storage::keys::TIMEZONE_ID_KEY)) {
+        return;
+    }
+    int index = timezones::DEFAULT_TIMEZONE_INDEX;
+    if (preferences.isKey(storage::keys::TIMEZONE_KEY)) {
+        // Older firmware saved the POSIX rule, which several zones share. The default zone is
+        // the likeliest owner of its own rule, otherwise any zone with the rule keeps the time right
+        char posixString[64] = "";
+        preferences.getString(storage::keys::TIMEZONE_KEY, posixString, sizeof(posixString));
+        if (strcmp(posixString, timezones::TIMEZONES[index].posixString()) != 0) {
+            index = timezones::findTimezoneIndex(posixString);
+        }
+        preferences.remove(storage::keys::TIMEZONE_KEY);
+        DEBUG_PRINT("Migrated saved timezone ");
+        DEBUG_PRINTLN(posixString);
+    }
+    preferences.putInt(storage::keys::TIMEZONE_ID_KEY, timezones::TIMEZONES[index].id);
+}
+
 void Storage::InitKeyIfMissing(const char* key, const int defaultValue) {
     if (!preferences.isKey(key)) {
         preferences.putInt(key, defaultValue);
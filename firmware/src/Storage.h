@@ -34,6 +34,8 @@ private:
 
     static void InitKeyIfMissing(const char* key, const int defaultValue);
     static void InitKeyIfMissing(const char* key, const char* defaultValue);
+    // Replaces the POSIX string saved by older firmware with the zone ID, or saves the default zone
+    static void MigrateTimezone();
 
 };
 
@@ -8,7 +8,11 @@ namespace storage
         static constexpr char HOT_UPPER_LIMIT_KEY[] = "h_upper";
         static constexpr char COLD_LOWER_LIMIT_KEY[] = "c_lower";
         static constexpr char COLD_UPPER_LIMIT_KEY[] = "c_upper";
+        static constexpr char TIMEZONE_ID_KEY[] = "tz_id";
+        // POSIX string saved by older firmware, only read to migrate it to TIMEZONE_ID_KEY
         static constexpr char TIMEZONE_KEY[] = "timezone";
+        // Last known wall clock, in seconds since the epoch, to restore it after a power cut
+        static constexpr char CLOCK_KEY[] = "clock";
     }
     namespace defaults
     {
@@ -16,6 +20,5 @@ namespace storage
         static constexpr int HOT_UPPER_LIMIT_DEFAULT = 32;
         static constexpr int COLD_LOWER_LIMIT_DEFAULT = 2;
         static constexpr int COLD_UPPER_LIMIT_DEFAULT = 7;
-        static constexpr char TIMEZONE_DEFAULT[] = "CET-1CEST,M3.5.0,M10.5.0/3";
     }
 }
\ No newline at end of file
@@ -11,71 +11,142 @@
 // defined in Timezones.h. These functions provide convenient access patterns
 // for continent-based navigation and timezone lookups.
 //
+// Continents are looked up through the CONTINENTS offsets in O(1), names,
+// POSIX strings and IDs by binary search, so none of them walks TIMEZONES.
+//
 // ============================================================================
 
 namespace timezones {
 
     // Get count of unique continents
     inline int getContinentCount() {
-        int count = 0;
-        const char* lastContinent = nullptr;
-        for (int i = 0; i < TIMEZONE_COUNT; i++) {
-            if (!lastContinent || strcmp(TIMEZONES[i].continent, lastContinent) != 0) {
-                count++;
-                lastContinent = TIMEZONES[i].continent;
-            }
-        }
-        return count;
+        return CONTINENT_COUNT;
     }
 
     // Get continent name by index (0-based)
     inline const char* getContinentName(int continentIndex) {
-        int currentContinent = -1;
-        const char* lastContinent = nullptr;
-        for (int i = 0; i < TIMEZONE_COUNT; i++) {
-            if (!lastContinent || strcmp(TIMEZONES[i].continent, lastContinent) != 0) {
-                currentContinent++;
-                lastContinent = TIMEZONES[i].continent;
-                if (currentContinent == continentIndex) {
-                    return lastContinent;
-                }
+        if (continentIndex < 0 || continentIndex >= CONTINENT_COUNT) {
+            return nullptr;
+        }
+        return CONTINENTS[continentIndex].name();
+    }
+
+    // Find continent index by name, -1 if not found
+    inline int findContinentIndex(const char* continent) {
+        int low = 0;
+        int high = CONTINENT_COUNT;
+        while (low < high) {
+            const int middle = (low + high) / 2;
+            const int order = strcmp(CONTINENTS[middle].name(), continent);
+            if (order == 0) {
+                return middle;
+            }
+            if (order < 0) {
+                low = middle + 1;
+            } else {
+                high = middle;
             }
         }
-        return nullptr;
+        return -1;
     }
 
     // Get timezone count for a continent
-    inline int getTimezoneCount(const char* continent) {
-        int count = 0;
-        for (int i = 0; i < TIMEZONE_COUNT; i++) {
-            if (strcmp(TIMEZONES[i].continent, continent) == 0) {
-                count++;
-            }
+    inline int getTimezoneCount(int continentIndex) {
+        if (continentIndex < 0 || continentIndex >= CONTINENT_COUNT) {
+            return 0;
         }
-        return count;
+        return CONTINENTS[continentIndex].end - CONTINENTS[continentIndex].begin;
+    }
+
+    inline int getTimezoneCount(const char* continent) {
+        return getTimezoneCount(findContinentIndex(continent));
     }
 
     // Get timezone by continent and local index
+    inline const Timezone* getTimezone(int continentIndex, int localIndex) {
+        if (localIndex < 0 || localIndex >= getTimezoneCount(continentIndex)) {
+            return nullptr;
+        }
+        return &TIMEZONES[CONTINENTS[continentIndex].begin + localIndex];
+    }
+
     inline const Timezone* getTimezone(const char* continent, int localIndex) {
-        int currentIndex = -1;
-        for (int i = 0; i < TIMEZONE_COUNT; i++) {
-            if (strcmp(TIMEZONES[i].continent, continent) == 0) {
-                currentIndex++;
-                if (currentIndex == localIndex) {
-                    return &TIMEZONES[i];
-                }
+        return getTimezone(findContinentIndex(continent), localIndex);
+    }
+
+    // Get the index of a timezone within its continent, from its global index
+    inline int getLocalTimezoneIndex(int timezoneIndex) {
+        if (timezoneIndex < 0 || timezoneIndex >= TIMEZONE_COUNT) {
+            return 0;
+        }
+        return timezoneIndex - CONTINENTS[TIMEZONES[timezoneIndex].continent].begin;
+    }
+
+    // Local index of the first timezone of the next initial letter after localIndex, or the
+    // timezone count when localIndex is in the last letter. A continent has at most a few dozen
+    // letters, so LETTER_INDEX is simply scanned.
+    inline int getNextLetterIndex(int continentIndex, int localIndex) {
+        if (continentIndex < 0 || continentIndex >= CONTINENT_COUNT) {
+            return 0;
+        }
+        const Continent& continent = CONTINENTS[continentIndex];
+        for (int letter = continent.letterBegin; letter < continent.letterEnd; letter++) {
+            if (LETTER_INDEX[letter] > continent.begin + localIndex) {
+                return LETTER_INDEX[letter] - continent.begin;
+            }
+        }
+        return continent.end - continent.begin;
+    }
+
+    // Local index of the first timezone of the initial letter of localIndex, or of the previous
+    // letter when localIndex already is the first of its own; -1 from the first timezone
+    inline int getPreviousLetterIndex(int continentIndex, int localIndex) {
+        if (continentIndex < 0 || continentIndex >= CONTINENT_COUNT) {
+            return -1;
+        }
+        const Continent& continent = CONTINENTS[continentIndex];
+        for (int letter = continent.letterEnd - 1; letter >= continent.letterBegin; letter--) {
+            if (LETTER_INDEX[letter] < continent.begin + localIndex) {
+                return LETTER_INDEX[letter] - continent.begin;
             }
         }
-        return nullptr;
+        return -1;
     }
 
-    // Find timezone global index by POSIX string
+    // Find timezone global index by POSIX string; the first one when several timezones share it
     inline int findTimezoneIndex(const char* posixString) {
-        for (int i = 0; i < TIMEZONE_COUNT; i++) {
-            if (strcmp(TIMEZONES[i].posixString, posixString) == 0) {
-                return i;
+        // Lower bound in POSIX_INDEX, which lands on the lowest index among equal strings
+        int low = 0;
+        int high = TIMEZONE_COUNT;
+        while (low < high) {
+            const int middle = (low + high) / 2;
+            if (strcmp(TIMEZONES[POSIX_INDEX[middle]].posixString(), posixString) < 0) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        if (low < TIMEZONE_COUNT && strcmp(TIMEZONES[POSIX_INDEX[low]].posixString(), posixString) == 0) {
+            return POSIX_INDEX[low];
+        }
+        return DEFAULT_TIMEZONE_INDEX;
+    }
+
+    // Find timezone global index by ID, as saved in storage
+    inline int findTimezoneIndexById(int id) {
+        int low = 0;
+        int high = TIMEZONE_COUNT;
+        while (low < high) {
+            const int middle = (low + high) / 2;
+            if (TIMEZONES[ID_INDEX[middle]].id < id) {
+                low = middle + 1;
+            } else {
+                high = middle;
             }
         }
+        if (low < TIMEZONE_COUNT && TIMEZONES[ID_INDEX[low]].id == id) {
+            return ID_INDEX[low];
+        }
         return DEFAULT_TIMEZONE_INDEX;
     }
 
@@ -0,0 +1,78 @@
+#include "TimezoneMenus.h"
+#include "MenuItems.h"
+#include "TimezoneHelpers.h"
+#include "AppContext.h"
+#include "services/IStorage.h"
+#include "StorageConstants.h"
+#include <functional>
+
+namespace {
+    // Saved timezone, as indices into timezoneMenu and timezoneListMenus
+    int currentContinentIndex = -1;
+    int currentLocalIndex = -1;
+}
+
+constexpr ContinentMenuList timezoneMenu;
+constexpr TimezoneMenuList timezoneListMenus[timezones::CONTINENT_COUNT];
+
+void refreshTimezoneSelection(AppContext* ctx) {
+    // Read current timezone
+    int currentTimezoneIndex = timezones::DEFAULT_TIMEZONE_INDEX;
+    if (ctx && ctx->storage) {
+        currentTimezoneIndex = timezones::findTimezoneIndexById(ctx->storage->getInt(storage::keys::TIMEZONE_ID_KEY));
+    }
+    // Find indices
+    currentContinentIndex = timezones::TIMEZONES[currentTimezoneIndex].continent;
+    currentLocalIndex = timezones::getLocalTimezoneIndex(currentTimezoneIndex);
+}
+
+uint16_t ContinentMenuList::getCount() const {
+    // One item per continent, plus "Retour"
+    return timezones::CONTINENT_COUNT + 1;
+}
+
+Menu::MenuItem ContinentMenuList::getItem(uint16_t index) const {
+    if (index >= timezones::CONTINENT_COUNT) {
+        return {"Retour", iconBack, &Menu::BACK, nullptr};
+    }
+    const uint8_t* icon = index == currentContinentIndex ? iconCheck : nullptr;
+    return {timezones::CONTINENTS[index].name(), icon, &timezoneListMenus[index], nullptr};
+}
+
+int TimezoneMenuList::getContinentIndex() const {
+    return this - timezoneListMenus;
+}
+
+const TimezoneMenuList* TimezoneMenuList::fromMenu(const Menu::MenuList* menu) {
+    // Told by its address alone, in O(1); std::less orders pointers to unrelated objects too
+    const std::less<const Menu::MenuList*> before;
+    if (menu == nullptr || before(menu, &timezoneListMenus[0]) || !before(menu, &timezoneListMenus[0] + timezones::CONTINENT_COUNT)) {
+        return nullptr;
+    }
+    return static_cast<const TimezoneMenuList*>(menu);
+}
+
+uint16_t TimezoneMenuList::getCount() const {
+    // The timezones of the continent, plus "Retour"
+    return timezones::getTimezoneCount(getContinentIndex()) + 1;
+}
+
+Menu::MenuItem TimezoneMenuList::getItem(uint16_t index) const {
+    const int continentIndex = getContinentIndex();
+    const timezones::Timezone* timezone = timezones::getTimezone(continentIndex, index);
+    if (timezone == nullptr) {
+        return {"Retour", iconBack, &Menu::BACK, nullptr};
+    }
+    const bool checked = continentIndex == currentContinentIndex && index == currentLocalIndex;
+    return {timezone->name(), checked ? iconCheck : nullptr, nullptr, &MenuActions::selectTimezoneByData};
+}
+
+uint16_t TimezoneMenuList::getLetterJump(uint16_t index, bool forward) const {
+    // "Retour" ends the list, as a letter of its own
+    const int continentIndex = getContinentIndex();
+    const int count = timezones::getTimezoneCount(continentIndex);
+    if (forward) {
+        return index >= count ? 0 : timezones::getNextLetterIndex(continentIndex, index);
+    }
+    return index == 0 ? count : timezones::getPreviousLetterIndex(continentIndex, index);
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "./screens/Menu.h"
+#include "Timezones.h"
+
+// Forward declaration for AppContext
+struct AppContext;
+
+// The timezone menus, built on the fly from the catalogue in Timezones.h rather than stored as
+// menu tables: one item per continent, then the timezones of the chosen continent. The saved
+// timezone and its continent carry the check mark.
+class ContinentMenuList : public Menu::MenuList {
+public:
+    constexpr ContinentMenuList() {}
+    uint16_t getCount() const override;
+    Menu::MenuItem getItem(uint16_t index) const override;
+};
+
+class TimezoneMenuList : public Menu::MenuList {
+public:
+    constexpr TimezoneMenuList() {}
+    uint16_t getCount() const override;
+    Menu::MenuItem getItem(uint16_t index) const override;
+    bool hasLetterIndex() const override { return true; }
+    uint16_t getLetterJump(uint16_t index, bool forward) const override;
+    // The lists hold no data: each one is told apart by its position in timezoneListMenus
+    int getContinentIndex() const;
+    // The list menu is one of timezoneListMenus, or nullptr for any other menu
+    static const TimezoneMenuList* fromMenu(const Menu::MenuList* menu);
+};
+
+extern const ContinentMenuList timezoneMenu;
+extern const TimezoneMenuList timezoneListMenus[timezones::CONTINENT_COUNT];
+
+// Read the saved timezone, so the check mark follows it (call at startup and after saving it)
+void refreshTimezoneSelection(AppContext* ctx = nullptr);
@@ -30,6 +30,8 @@
 #include "screens/views/DataDisplayView.h"
 #include "screens/views/ConfirmTimezoneView.h"
 #include "screens/views/PowerOffView.h"
+#include "screens/views/ChartView.h"
+#include "screens/views/MenuView.h"
 #include "ScreensManager.h"
 #include "Storage.h"
 #include "TemperatureController.h"
@@ -94,6 +96,8 @@ static WiFiResetView wifiResetView(&displayManager);
 static DataDisplayView dataDisplayView(&displayManager);
 static ConfirmTimezoneView confirmTimezoneView(&displayManager);
 static PowerOffView powerOffView(&displayManager);
+static ChartView chartView(&displayManager);
+static MenuView menuView(&displayManager);
 
 void setup() {
 #if defined CORE_DEBUG_LEVEL && CORE_DEBUG_LEVEL > ARDUHAL_LOG_LEVEL_NONE
@@ -149,9 +153,12 @@ void setup() {
     appContext.dataDisplayView = &dataDisplayView;
     appContext.confirmTimezoneView = &confirmTimezoneView;
     appContext.powerOffView = &powerOffView;
+    appContext.chartView = &chartView;
+    appContext.menuView = &menuView;
 
     // Provide storage to TemperatureController now that AppContext.storage is set
     temperatureController.setStorage(appContext.storage);
+    networkService.setStorage(appContext.storage);
 
     // Create remaining objects that depend on appContext being fully initialized
     static Initialization initializationInstance(&appContext);
@@ -163,8 +170,8 @@ void setup() {
     static Menu menuInstance(&appContext, menuActions);
     menu = &menuInstance;
     
-    // Initialize dynamic timezone menus
-    initializeAllMenus(&appContext);
+    // Check mark on the saved timezone in the timezone menus
+    refreshTimezoneSelection(&appContext);
     
     // Set the menu instance in MenuActions for context-aware actions
     menuActions->setMenu(&menuInstance);
@@ -175,5 +182,11 @@ void setup() {
 
 void loop() {
     inputManager.update();
+    if (inputManager.hasActivity() && displayManager.wake()) {
+        // The screen was off: this input only turns it back on, rather than acting on a screen the user could not see
+        inputManager.discardPendingInput();
+    }
+    networkService.update();
     screensManager.update();
+    displayManager.update();
 }
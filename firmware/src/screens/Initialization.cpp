@@ -1,16 +1,13 @@
-#include <time.h>
 #include <U8g2lib.h>
-#include <esp_timer.h>
-#include <freertos/FreeRTOS.h>
-#include <freertos/task.h>
-#include "DebugUtils.h"
+#include "Fonts.h"
 #include "Initialization.h"
-#include "icons.h"
-// Need the concrete service definition to call methods like autoConnect()/configureNtp()
+// Need the concrete service definition to call methods like begin()/configureNtp()
 #include "../services/INetworkService.h"
 // Storage interface to retrieve timezone configuration
 #include "../services/IStorage.h"
 #include "StorageConstants.h"
+#include "Timezones.h"
+#include "TimezoneHelpers.h"
 
 Initialization::Initialization(AppContext* ctx) : BaseController(ctx), _display(nullptr), _networkService(nullptr), _storage(nullptr)
 {}
@@ -35,53 +32,17 @@ bool Initialization::update(bool forceRedraw) {
 }
 
 
+// Starts the network in the background, so the menu (and the temperature control) comes up at
+// once instead of after the WiFi connection, the captive portal and the NTP sync
 void Initialization::drawScreen() {
     _display->clearBuffer();
-    _display->setFont(u8g2_font_t0_11_tf);
+    _display->setFont(fonts::REGULAR);
     _display->drawStr(0, 10, "Initialisation...");
-    _display->drawStr(0, 22, "Connexion au WiFi...");
-    _display->sendBuffer();
+    _display->flush();
 
-    // Use the injected network service to connect; continue on failure after a short timeout
-    bool wifiConnected = false;
+    // Set the timezone first, so local time follows it before the network is up
+    const int timezoneIndex = timezones::findTimezoneIndexById(_storage->getInt(storage::keys::TIMEZONE_ID_KEY));
+    _networkService->configureNtp(timezones::TIMEZONES[timezoneIndex].posixString(), "pool.ntp.org", "time.nist.gov");
     // Name the captive portal so users can spot it easily
-    const char* portalName = "ProofingChamber";
-    wifiConnected = _networkService->autoConnect(portalName, [this](const char* apName) {
-        if (!_display) return;
-        _display->clearBuffer();
-        _display->setFont(u8g2_font_t0_11_tf);
-        _display->drawStr(0, 10, "Portail WiFi actif");
-        _display->drawStr(0, 22, "Connectez-vous :");
-        const char* safeName = apName ? apName : "ConfigPortal";
-        _display->drawStr(0, 34, safeName);
-        _display->sendBuffer();
-    });
-    if (!wifiConnected) {
-        _display->drawUTF8(0, 34, "WiFi indisponible.");
-        _display->sendBuffer();
-        return; // Do not hang the boot if WiFi is down
-    }
-
-    _display->drawUTF8(0, 34, "Succ\xC3\xA8s.");
-    _display->drawStr(0, 46, "Connexion au NTP...");
-    _display->sendBuffer();
-    _display->setCursor(0, 58);
-
-    // Configure NTP via network service
-    char timezoneBuf[64];
-    _storage->getCharArray(storage::keys::TIMEZONE_KEY, timezoneBuf, sizeof(timezoneBuf), storage::defaults::TIMEZONE_DEFAULT);
-    _networkService->configureNtp(timezoneBuf, "pool.ntp.org", "time.nist.gov");
-    DEBUG_PRINT("Waiting for NTP time sync");
-    const uint64_t timeout_us = esp_timer_get_time() + 30000000ULL; // 30 sec timeout
-    while (!_networkService->isTimeSyncReady(1000000000)) {
-        if (esp_timer_get_time() > timeout_us) {
-            DEBUG_PRINTLN("NTP timeout - continuing anyway");
-            break;
-        }
-        vTaskDelay(pdMS_TO_TICKS(500));
-        _display->print(".");
-        _display->sendBuffer();
-        taskYIELD();
-    }
-    DEBUG_PRINTLN("\nTime synced with NTP");
+    _networkService->begin("ProofingChamber");
 }
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "BaseController.h"
-#include "../IDisplayManager.h"
+#include "../DisplayBackend.h"
 #include "../AppContextDecl.h"
 // Storage interface for reading saved timezone
 #include "../services/IStorage.h"
@@ -13,7 +13,7 @@ public:
     bool update(bool forceRedraw = false) override;
 
 private:
-    IDisplayManager* _display;
+    DisplayBackend* _display;
     services::INetworkService* _networkService;
     services::IStorage* _storage;
     void drawScreen();
@@ -3,20 +3,23 @@
 #include <Arduino.h>
 #include <functional>
 #include "../screens/BaseController.h"
-#include "../IDisplayManager.h"
+#include "../DisplayBackend.h"
 #include "../IInputManager.h"
 #include "../ScreensManager.h"
 #include "../MenuActions.h"
 #include "../AppContextDecl.h"
+#include "MenuList.h"
+#include "views/MenuView.h"
 
 class Menu : public BaseController {
 public:
-    struct MenuItem {
-        const char* name;               // Name of the menu item (stored in PROGMEM)
-        const uint8_t* icon;            // Icon for the menu item (nullptr if no icon)
-        MenuItem* subMenu;              // Pointer to submenu (nullptr if no submenu)
-        void (MenuActions::*action)();  // Action as method pointer (nullptr if no action)
-    };
+    // Defined in MenuList.h
+    using MenuItem = ::MenuItem;
+    using MenuList = ::MenuList;
+    using StaticMenuList = ::StaticMenuList;
+    using BackMenuList = ::BackMenuList;
+
+    static const BackMenuList BACK;
 
     Menu(AppContext* ctx, MenuActions* menuActions);
     void begin();
@@ -24,59 +27,78 @@ public:
     bool update(bool forceRedraw = false) override;
     
     // Expose current menu state for context-aware actions
-    MenuItem* getCurrentMenu() const { return _currentMenu; }
-    uint8_t getCurrentMenuIndex() const { return _menuIndex; }
+    const MenuList* getCurrentMenu() const { return _currentMenu; }
+    uint16_t getCurrentMenuIndex() const { return _menuIndex; }
+
+    // Programmatically set the current menu (e.g., return to Advanced settings). A menu that was
+    // opened on the way to the current one is returned to, on the item it was left from.
+    void setCurrentMenu(const MenuList* menu);
 
-    // Programmatically set the current menu (e.g., return to Advanced settings)
-    void setCurrentMenu(MenuItem* menu);
+    // Show a short message in a banner across the top for MESSAGE_DURATION_MS, e.g. to tell why an
+    // action did nothing. The text must stay valid.
+    void showMessage(const char* text);
 
 private:
-    MenuItem* _currentMenu;
-    uint8_t _menuIndex = 0;
-    int16_t _scrollOffset = 0;  // Can be negative for circular scrolling
-    uint8_t _currentMenuSize = 0;
-    
-    // Smooth scrolling state
-    float _scrollOffsetFloat = 0;
-    float _targetScrollOffset = 0;
+    const MenuList* _currentMenu;
+    uint16_t _menuIndex = 0;
+    uint16_t _currentMenuSize = 0;
 
-    static const uint8_t MAX_VISIBLE_ITEMS = 4;
-    static const uint8_t SELECTION_POSITION = 2;  // Fixed position where selection is drawn (0-3, 2 = centered/third from top)
-    static const uint8_t MENU_ITEM_HEIGHT = 16;
-    static const uint8_t MENU_ICON_X_OFFSET = 3;
-    static const int8_t MENU_ICON_Y_OFFSET = -9;
-    static const uint8_t MENU_ICON_WIDTH = 10;
-    static const uint8_t MENU_ICON_HEIGHT = 10;
-    static const uint8_t MENU_TEXT_X_OFFSET = 16;
-    static const uint8_t MENU_SELECTION_X_OFFSET = 0;
-    static const int8_t MENU_SELECTION_Y_OFFSET = -12;
-    static const uint8_t MENU_SELECTION_HEIGHT = 15;
-    static const uint8_t MENU_SELECTION_RADIUS = 1;
+    // Menus the current one was opened from, and the item selected in each, innermost last. Kept
+    // in a ring so that, past MAX_MENU_DEPTH levels, the outermost ones are forgotten.
+    struct MenuLevel {
+        const MenuList* menu;
+        uint16_t index;
+    };
+    static const uint8_t MAX_MENU_DEPTH = 6;
+    MenuLevel _parents[MAX_MENU_DEPTH];
+    uint8_t _parentsStart = 0;
+    uint8_t _parentsCount = 0;
     
-    // Pre-calculated integer positions (set in begin())
-    int16_t _selectionCenterY = 0;  // Y coordinate of selection box center
-    int16_t _itemBaseY = 0;  // Base Y position for menu items (where displayIndex=0 would be)
-    int8_t _menuItemYOffset = 0;  // Calculated offset to center text vertically (font baseline adjustment)
+    // Smooth scrolling state: the scroll position, in 1/SCROLL_UNIT of an item from item 0 at the
+    // top (negative when the first items sit below the top), eases from _scrollStart to
+    // _scrollTarget over SCROLL_DURATION_MS from _scrollStartTime
+    int32_t _scrollPosition = 0;
+    int32_t _scrollStart = 0;
+    int32_t _scrollTarget = 0;
+    uint32_t _scrollStartTime = 0;
+    bool _redrawPending = false;  // A redraw was requested but the next display frame is not due yet
 
-    static const uint8_t SCROLLBAR_WIDTH = 3;
-    static const uint8_t SCROLLBAR_X_OFFSET = 2;
-    static const uint8_t SCROLLBAR_Y_MARGIN = 2;
-    
-    // Smooth scrolling animation
-    static constexpr float ANIMATION_SPEED = 0.25f;  // Interpolation factor (0-1, higher = faster)
-    static constexpr float ANIMATION_CONVERGENCE_THRESHOLD = 0.1f;  // Pixels - stop animating when this close to target
-    static constexpr float SCROLL_RENDER_THRESHOLD = 0.01f;  // Fractional offset - render extra items when scrolling
+    // Letter jump mode, entered by turning the encoder fast in a list with a letter index: each
+    // detent then moves to the next or previous initial letter, until the encoder rests
+    bool _letterJump = false;
+    uint8_t _fastSteps = 0;  // Consecutive detents less than FAST_STEP_INTERVAL_MS apart
+    uint32_t _lastStepTime = 0;
+
+    // The WiFi portal is open, and announced in a banner across the top
+    bool _portalShown = false;
+    // Message shown in the banner instead, since _messageTime
+    const char* _message = nullptr;
+    uint32_t _messageTime = 0;
+
+    // Smooth scrolling animation, in integer maths since the C3 has no FPU
+    static constexpr int32_t SCROLL_UNIT = MenuView::SCROLL_UNIT;  // Fixed-point scale of the scroll position
+    static constexpr int32_t SCROLL_DURATION_MS = 200;
+    static constexpr int32_t MAX_SCROLL_DISTANCE = MenuView::MAX_VISIBLE_ITEMS * SCROLL_UNIT;  // Longer jumps only animate their end
     
     // Input processing
     static constexpr uint8_t MAX_ENCODER_STEPS_PER_UPDATE = 20;  // Safety limit for encoder step processing loop
+    static constexpr uint32_t FAST_STEP_INTERVAL_MS = 60;
+    static constexpr uint8_t FAST_STEPS_FOR_LETTER_JUMP = 6;
+    static constexpr uint32_t LETTER_JUMP_TIMEOUT_MS = 1000;  // Rest that leaves the letter jump mode
+
+    static constexpr uint32_t MESSAGE_DURATION_MS = 2000;
 
     MenuActions* _menuActions;
-    IDisplayManager* _display;
+    DisplayBackend* _display;
+    MenuView* _view;
 
     // Helper functions
     void drawMenu();
-    uint8_t getCurrentMenuSize() const;
     bool handleMenuSelection();
+    void showMenu(const MenuList* menu, uint16_t index);
+    void goBack();
 
-    void drawScrollbar();
+    bool isPortalOpen() const;
+    int32_t getScrollPosition(uint32_t now) const;
+    void resetScroll();
 };
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Menu contents, apart from Menu itself so that MenuView and the host view tests can draw them
+// without the controllers; Menu exposes them under its own scope, as Menu::MenuList and so on
+
+class MenuActions;
+class MenuList;
+
+struct MenuItem {
+    const char* name;               // Name of the menu item (stored in PROGMEM)
+    const uint8_t* icon;            // Icon for the menu item (nullptr if no icon)
+    const MenuList* subMenu;        // Pointer to submenu (nullptr if no submenu)
+    void (MenuActions::*action)();  // Action as method pointer (nullptr if no action)
+};
+
+// Items of a menu, read one at a time: only the rows on screen are ever asked for, so long
+// generated lists can build their items on the fly instead of being stored
+class MenuList {
+public:
+    virtual uint16_t getCount() const = 0;
+    virtual MenuItem getItem(uint16_t index) const = 0;
+    // Lists sorted by name can index their initial letters, for the letter jump mode: the
+    // index of the first item of the next letter, or of the current (or previous) one
+    virtual bool hasLetterIndex() const { return false; }
+    virtual uint16_t getLetterJump(uint16_t index, bool forward) const { return index; }
+};
+
+// List over a constexpr MenuItem array, sized at compile time. Defined constexpr too, a list
+// stays in flash and fails to compile if an item has no name, or has neither or both of a
+// submenu and an action.
+class StaticMenuList : public MenuList {
+public:
+    template <size_t N>
+    constexpr StaticMenuList(const MenuItem (&items)[N]) : _items(items), _count(checkItems(items, N)) {}
+    uint16_t getCount() const override { return _count; }
+    MenuItem getItem(uint16_t index) const override { return _items[index]; }
+
+private:
+    // Item count, once every item is checked; a throw is not a constant expression, so it
+    // turns a bad item into a compilation error quoting its message
+    static constexpr uint16_t checkItems(const MenuItem* items, size_t count, size_t index = 0) {
+        return index == count ? static_cast<uint16_t>(count)
+            : items[index].name == nullptr ? throw "menu item without a name"
+            : (items[index].subMenu == nullptr) == (items[index].action == nullptr)
+                ? throw "menu item needs either a submenu or an action"
+            : checkItems(items, count, index + 1);
+    }
+
+    const MenuItem* _items;
+    uint16_t _count;
+};
+
+// Empty list standing for the menu the current one was opened from; "Retour" items lead to
+// &Menu::BACK instead of naming their parent
+class BackMenuList : public MenuList {
+public:
+    constexpr BackMenuList() {}
+    uint16_t getCount() const override { return 0; }
+    MenuItem getItem(uint16_t index) const override { return {nullptr, nullptr, nullptr, nullptr}; }
+};
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "../BaseController.h"
-#include "../../IDisplayManager.h"
+#include "../../DisplayBackend.h"
 #include "../../IInputManager.h"
 #include "../../services/IStorage.h"
 
@@ -5,14 +5,14 @@
 #include "../../screens/Menu.h"
 #include "../../MenuItems.h"
 #include <StorageConstants.h>
+#include "../../Timezones.h"
+#include "../../TimezoneHelpers.h"
 
 ConfirmTimezoneController::ConfirmTimezoneController(AppContext* ctx)
     : BaseController(ctx), _view(nullptr) {}
 
-void ConfirmTimezoneController::setTimezoneInfo(const char* continent, const char* tzName, const char* posixString) {
-    _timezoneContinentName = continent;
-    _timezoneDisplayName = tzName;
-    _timezonePosixString = posixString;
+void ConfirmTimezoneController::setTimezoneInfo(int timezoneIndex) {
+    _timezoneIndex = timezoneIndex;
 }
 
 void ConfirmTimezoneController::beginImpl() {
@@ -23,8 +23,9 @@ void ConfirmTimezoneController::beginImpl() {
     }
     _onCancelButton = true;
     
-    if (_view && _timezoneDisplayName) {
-        _view->setTimezone(_timezoneContinentName, _timezoneDisplayName);
+    if (_view && _timezoneIndex >= 0) {
+        const timezones::Timezone& timezone = timezones::TIMEZONES[_timezoneIndex];
+        _view->setTimezone(timezones::getContinentName(timezone.continent), timezone.name());
         _view->start();
         _view->sendBuffer();
     }
@@ -45,24 +46,25 @@ bool ConfirmTimezoneController::update(bool shouldRedraw) {
         }
         // Confirm timezone selection
         AppContext* ctx = getContext();
-        if (ctx && ctx->storage && _timezonePosixString) {
-            ctx->storage->setCharArray(storage::keys::TIMEZONE_KEY, _timezonePosixString);
+        if (ctx && ctx->storage && _timezoneIndex >= 0) {
+            const timezones::Timezone& timezone = timezones::TIMEZONES[_timezoneIndex];
+            ctx->storage->setInt(storage::keys::TIMEZONE_ID_KEY, timezone.id);
             DEBUG_PRINT("Timezone confirmed and saved: ");
-            DEBUG_PRINTLN(_timezonePosixString);
+            DEBUG_PRINTLN(timezone.name());
             
             // Apply the timezone change immediately without requiring a reboot
             if (ctx->networkService) {
-                ctx->networkService->configureNtp(_timezonePosixString, "pool.ntp.org", "time.nist.gov");
+                ctx->networkService->configureNtp(timezone.posixString(), "pool.ntp.org", "time.nist.gov");
                 DEBUG_PRINTLN("Timezone applied immediately");
             }
-            // Refresh menu icons to reflect the new selection
-            refreshTimezoneSelectionIcons(ctx);
+            // Move the menu check mark to the new selection
+            refreshTimezoneSelection(ctx);
         }
         // Return to Advanced settings menu
         BaseController* next = getNextScreen();
         Menu* menu = static_cast<Menu*>(next);
         if (menu) {
-            menu->setCurrentMenu(moreSettingsMenu);
+            menu->setCurrentMenu(&moreSettingsMenu);
         }
         // Finish this screen to trigger transition
         return false;
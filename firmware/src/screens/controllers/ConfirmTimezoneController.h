@@ -4,7 +4,6 @@
 #include "../../AppContextDecl.h"
 
 // Forward declarations
-class IDisplayManager;
 class ConfirmTimezoneView;
 class IInputManager;
 
@@ -13,15 +12,13 @@ public:
     ConfirmTimezoneController(AppContext* ctx);
     bool update(bool forceRedraw = false) override;
 
-    // Set the timezone info to confirm
-    void setTimezoneInfo(const char* continent, const char* tzName, const char* posixString);
+    // Set the timezone to confirm, as an index in timezones::TIMEZONES
+    void setTimezoneInfo(int timezoneIndex);
 
 private:
     ConfirmTimezoneView* _view;
     bool _onCancelButton = true;
-    const char* _timezoneDisplayName = nullptr;
-    const char* _timezonePosixString = nullptr;
-    const char* _timezoneContinentName = nullptr;
+    int _timezoneIndex = -1;
 
     void beginImpl() override;
 };
@@ -1,6 +1,7 @@
 #include "CoolingController.h"
 #include "DebugUtils.h"
 #include "../views/CoolingView.h"
+#include <esp_timer.h>
 
 CoolingController::CoolingController(AppContext* ctx)
     : BaseController(ctx), _view(nullptr), _temperatureController(nullptr),
@@ -17,28 +18,57 @@ void CoolingController::beginImpl() {
     
     getInputManager()->slowTemperaturePolling(false);
     _endTime = _timeCalculator ? _timeCalculator() : 0;
+    _clockOffset = time(nullptr) - (time_t)(esp_timer_get_time() / 1000000ULL);
     _lastUpdateTime = 0;
     _lastGraphUpdate = 0;
-    _onCancelButton = true;
+    _selection = CoolingView::Selection::Cancel;
+    _chart.close();
     _temperatureController->setMode(ITemperatureController::COOLING);
-    _temperatureGraph.configure(30, 15, -5.0, 60.0, true);
-    _view->start(_endTime, _onCancelButton, _temperatureGraph);
+    _temperatureGraph.configure(30, 15, true);
+    _view->start(_endTime, _selection, _temperatureGraph);
 }
 
 bool CoolingController::update(bool shouldRedraw) {
     IInputManager* inputManager = getInputManager();
-    struct tm tm_now;
-    getLocalTime(&tm_now);
-    const time_t now = mktime(&tm_now);
+    // Regulation runs on the time since boot, which goes on steadily whatever the network does
+    const time_t uptime = (time_t)(esp_timer_get_time() / 1000000ULL);
+    const time_t now = time(nullptr);
 
     if (shouldRedraw) {
         _endTime = _timeCalculator ? _timeCalculator() : _endTime;
     }
+    // The wall clock jumps when NTP sets it, which can happen after the boot: keep the time left
+    // rather than the end time, computed with the clock counting from boot
+    const time_t clockOffset = now - uptime;
+    if (clockOffset - _clockOffset >= CLOCK_STEP_SECONDS || _clockOffset - clockOffset >= CLOCK_STEP_SECONDS) {
+        _endTime += clockOffset - _clockOffset;
+        if (!_chart.isOpen()) {
+            _view->start(_endTime, _selection, _temperatureGraph);
+            shouldRedraw = true;
+        }
+    }
+    _clockOffset = clockOffset;
     bool timesUp = now >= _endTime;
-    if (inputManager->isButtonPressed() || timesUp) {
+    bool buttonPressed = false;
+    if (_chart.isOpen()) {
+        if (!_chart.handleInput(inputManager)) {
+            // Back from the chart: redraw the whole screen, the graph still selected
+            _view->start(_endTime, _selection, _temperatureGraph);
+            _lastUpdateTime = 0;
+            shouldRedraw = true;
+        }
+    } else {
+        buttonPressed = inputManager->isButtonPressed();
+        if (buttonPressed && _selection == CoolingView::Selection::Graph && !timesUp) {
+            _chart.open(getContext()->chartView, &_temperatureGraph, GRAPH_INTERVAL_SECONDS);
+            buttonPressed = false;
+        }
+    }
+    if (buttonPressed || timesUp) {
+        _chart.close();
         inputManager->slowTemperaturePolling(true);
         _temperatureController->setMode(ITemperatureController::OFF);
-        bool goingToProofScreen = !_onCancelButton || timesUp;
+        bool goingToProofScreen = _selection == CoolingView::Selection::Start || timesUp;
         BaseController* nextScreen = goingToProofScreen ? _proofingController : _menuScreen;
         setNextScreen(nextScreen);
         if (goingToProofScreen && _proofingController) {
@@ -47,27 +77,46 @@ bool CoolingController::update(bool shouldRedraw) {
         if (nextScreen) nextScreen->begin();
         return false;
     }
-    if (difftime(now, _lastUpdateTime) >= 1) {
+
+    bool graphUpdated = false;
+    if (difftime(uptime, _lastUpdateTime) >= 1) {
         const float currentTemp = inputManager->getTemperature();
-        _temperatureGraph.addValueToAverage(currentTemp);
-        shouldRedraw |= _view->drawTemperature(currentTemp);
+        // Relay state over the second that just ended, before update() switches it
+        const uint8_t relays = (_temperatureController->isHeating() ? Graph::HEATER : 0)
+                             | (_temperatureController->isCooling() ? Graph::COOLER : 0);
+        _temperatureGraph.addValueToAverage(currentTemp, relays);
         _temperatureController->update(currentTemp);
-        shouldRedraw |= _view->drawTime(difftime(_endTime, now));
-        _lastUpdateTime = now;
-        if (difftime(now, _lastGraphUpdate) >= 10.0) {
+        _lastUpdateTime = uptime;
+        if (difftime(uptime, _lastGraphUpdate) >= GRAPH_INTERVAL_SECONDS) {
             _temperatureGraph.commitAverage(currentTemp);
-            _lastGraphUpdate = now;
-            _view->drawGraph(_temperatureGraph);
-            shouldRedraw = true;
+            _lastGraphUpdate = uptime;
+            graphUpdated = true;
+        }
+        if (!_chart.isOpen()) {
+            shouldRedraw |= _view->drawTemperature(currentTemp);
+            shouldRedraw |= _view->drawTime(difftime(_endTime, now));
+            if (graphUpdated) {
+                _view->drawGraph(_temperatureGraph);
+                shouldRedraw = true;
+            }
+        }
+    }
+
+    // Regulation carries on while the chart is shown, only the view is left alone
+    if (_chart.isOpen()) {
+        if (graphUpdated) {
+            _chart.onPointAdded();
         }
+        return true;
     }
 
     shouldRedraw |= _view->drawIcons(OptionalBool(_temperatureController->isCooling()));
 
     auto encoderDirection = inputManager->getEncoderDirection();
     if (encoderDirection != IInputManager::EncoderDirection::None) {
-        _onCancelButton = !_onCancelButton;
-        _view->drawButtons(_onCancelButton);
+        const uint8_t step = encoderDirection == IInputManager::EncoderDirection::Clockwise ? 1 : CoolingView::SELECTION_COUNT - 1;
+        _selection = static_cast<CoolingView::Selection>((static_cast<uint8_t>(_selection) + step) % CoolingView::SELECTION_COUNT);
+        _view->drawSelection(_selection, _temperatureGraph);
         shouldRedraw = true;
     }
 
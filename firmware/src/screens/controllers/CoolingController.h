@@ -4,6 +4,7 @@
 #include "../views/CoolingView.h"
 #include "../../IInputManager.h"
 #include "../../ITemperatureController.h"
+#include "HistoryChart.h"
 #include <ctime>
 
 class CoolingController : public BaseController {
@@ -16,15 +17,21 @@ public:
     void prepare(TimeCalculatorCallback callback, BaseController* proofingController, BaseController* menuScreen);
 
 private:
+    static constexpr uint16_t GRAPH_INTERVAL_SECONDS = 10;
+    // A larger step of the wall clock is NTP setting it, rather than time passing
+    static constexpr time_t CLOCK_STEP_SECONDS = 2;
+
     CoolingView* _view;
     ITemperatureController* _temperatureController;
-    time_t _endTime;
-    time_t _lastUpdateTime;
-    time_t _lastGraphUpdate;
-    bool _onCancelButton;
+    time_t _endTime;          // Wall clock
+    time_t _clockOffset;      // Wall clock minus seconds since boot, to spot it being set
+    time_t _lastUpdateTime;   // Seconds since boot
+    time_t _lastGraphUpdate;  // Seconds since boot
+    CoolingView::Selection _selection;
     TimeCalculatorCallback _timeCalculator;
     BaseController* _proofingController;
     BaseController* _menuScreen;
     Graph _temperatureGraph;
+    HistoryChart _chart;
     float _currentTemp;
 };
@@ -2,7 +2,10 @@
 #include "../views/DataDisplayView.h"
 #include "DebugUtils.h"
 #include "services/IStorage.h"
+#include "services/INetworkService.h"
 #include "StorageConstants.h"
+#include "Timezones.h"
+#include "TimezoneHelpers.h"
 
 void DataDisplayController::beginImpl() {
     DEBUG_PRINTLN("DataDisplayController::beginImpl called");
@@ -11,10 +14,11 @@ void DataDisplayController::beginImpl() {
     AppContext* ctx = getContext();
     _view = ctx->dataDisplayView;
     _view->start();
-    char buffer[50] = {0};
     services::IStorage* storage = ctx->storage;
     if (storage) {
-        storage->getCharArray(storage::keys::TIMEZONE_KEY, buffer, sizeof(buffer));
+        const timezones::Timezone& timezone = timezones::TIMEZONES[timezones::findTimezoneIndexById(storage->getInt(storage::keys::TIMEZONE_ID_KEY))];
+        char buffer[64] = {0};
+        snprintf(buffer, sizeof(buffer), "%s/%s", timezones::getContinentName(timezone.continent), timezone.name());
         _view->drawTimeZone(buffer);
     }
     _view->sendBuffer();
@@ -29,14 +33,18 @@ bool DataDisplayController::update(bool forceRedraw) {
         return false;
     }
 
-    struct tm tm_now;
-    getLocalTime(&tm_now);
-    const time_t now = mktime(&tm_now);
+    const time_t now = time(nullptr);
     if (difftime(now, _lastUpdateTime) >= 1) {
         const float currentTemp = input->getTemperature();
         _lastUpdateTime = now;
         forceRedraw |= _view->drawTemperature(currentTemp);
-        forceRedraw |= _view->drawTime(tm_now);
+        // Only show the time once it is known
+        services::INetworkService* network = getContext()->networkService;
+        if (network && network->isTimeKnown()) {
+            struct tm tm_now;
+            localtime_r(&now, &tm_now);
+            forceRedraw |= _view->drawTime(tm_now, network->isTimeEstimated());
+        }
 
         services::IStorage* storage = getContext()->storage;
     }
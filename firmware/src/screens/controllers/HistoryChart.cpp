@@ -0,0 +1,81 @@
+#include "HistoryChart.h"
+#include "../views/ChartView.h"
+
+// Indexed at runtime, so defined here too as C++11 requires
+constexpr HistoryChart::Zoom HistoryChart::ZOOM_LEVELS[];
+
+void HistoryChart::open(ChartView* view, const Graph* graph, uint16_t secondsPerPoint) {
+    _view = view;
+    _graph = graph;
+    _secondsPerPoint = secondsPerPoint;
+    // Start with the whole session on screen
+    const uint8_t level = graph->getLevelFor(ChartView::getVisiblePoints(1));
+    _zoomLevel = 0;
+    while (_zoomLevel + 1 < ZOOM_LEVEL_COUNT && ZOOM_LEVELS[_zoomLevel].level != level) {
+        _zoomLevel++;
+    }
+    _offset = 0;
+    _panning = false;
+    _view->reset();
+    draw();
+}
+
+bool HistoryChart::handleInput(IInputManager* input) {
+    if (input->isButtonPressed()) {
+        if (!_panning) {
+            _panning = true;
+            draw();
+            return true;
+        }
+        close();
+        return false;
+    }
+
+    const auto encoderDirection = input->getEncoderDirection();
+    if (encoderDirection == IInputManager::EncoderDirection::None) {
+        return true;
+    }
+    const bool clockwise = encoderDirection == IInputManager::EncoderDirection::Clockwise;
+    if (_panning) {
+        // Clockwise goes towards the latest points
+        const uint8_t step = max(1, ChartView::getVisiblePoints(ZOOM_LEVELS[_zoomLevel].pixelsPerPoint) / PAN_STEPS_PER_SCREEN);
+        _offset = clockwise ? _offset - min(_offset, step) : min<uint16_t>(getMaxOffset(), _offset + step);
+    } else {
+        // Clockwise zooms in
+        const uint8_t previousLevel = ZOOM_LEVELS[_zoomLevel].level;
+        if (clockwise && _zoomLevel + 1 < ZOOM_LEVEL_COUNT) {
+            _zoomLevel++;
+        } else if (!clockwise && _zoomLevel > 0) {
+            _zoomLevel--;
+        } else {
+            return true;
+        }
+        // Keep the right edge of the window at the same time
+        const uint32_t offset = (uint32_t)_offset * Graph::getLevelScale(previousLevel) / Graph::getLevelScale(ZOOM_LEVELS[_zoomLevel].level);
+        _offset = min<uint32_t>(offset, getMaxOffset());
+    }
+    draw();
+    return true;
+}
+
+void HistoryChart::onPointAdded() {
+    // A panned window moves back by one point whenever its level gets a new one
+    const uint16_t scale = Graph::getLevelScale(ZOOM_LEVELS[_zoomLevel].level);
+    if (_offset > 0 && _graph->getTotalPoints() % scale == 0) {
+        _offset = min<uint16_t>(getMaxOffset(), _offset + 1);
+    }
+    draw();
+}
+
+uint8_t HistoryChart::getMaxOffset() const {
+    const Zoom& zoom = ZOOM_LEVELS[_zoomLevel];
+    const uint8_t visiblePoints = ChartView::getVisiblePoints(zoom.pixelsPerPoint);
+    const uint8_t pointCount = _graph->getPointCount(zoom.level);
+    return pointCount > visiblePoints ? pointCount - visiblePoints : 0;
+}
+
+void HistoryChart::draw() {
+    const Zoom& zoom = ZOOM_LEVELS[_zoomLevel];
+    _view->draw(*_graph, zoom.level, zoom.pixelsPerPoint, _offset, _secondsPerPoint * Graph::getLevelScale(zoom.level), _panning);
+    _view->sendBuffer();
+}
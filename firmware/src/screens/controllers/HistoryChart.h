@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../../IInputManager.h"
+#include "../../Graph.h"
+
+class ChartView;
+
+// Full-screen chart opened from the proofing and cooling screens. It is not a screen of its own:
+// the owning controller keeps regulating while it is open, and forwards its input here.
+class HistoryChart {
+public:
+    void open(ChartView* view, const Graph* graph, uint16_t secondsPerPoint);
+    void close() { _view = nullptr; }
+    bool isOpen() const { return _view != nullptr; }
+    // The encoder zooms, then pans once the button is pressed; a second press closes the chart.
+    // Zooming out past one pixel per point moves to the coarser levels of the graph history.
+    // Returns false once the chart is closed
+    bool handleInput(IInputManager* input);
+    // Redraws after a point was added to the graph, keeping a panned window on the same points
+    void onPointAdded();
+
+private:
+    struct Zoom {
+        uint8_t level;          // Graph history level
+        uint8_t pixelsPerPoint;
+    };
+    // From the widest to the closest
+    static constexpr Zoom ZOOM_LEVELS[] = {{3, 1}, {2, 1}, {1, 1}, {0, 1}, {0, 2}, {0, 4}};
+    static constexpr uint8_t ZOOM_LEVEL_COUNT = sizeof(ZOOM_LEVELS) / sizeof(ZOOM_LEVELS[0]);
+    // Encoder steps needed to pan across one screen
+    static constexpr uint8_t PAN_STEPS_PER_SCREEN = 8;
+
+    ChartView* _view = nullptr;
+    const Graph* _graph = nullptr;
+    uint16_t _secondsPerPoint = 0;
+    uint8_t _zoomLevel = 0;
+    uint8_t _offset = 0;
+    bool _panning = false;
+
+    uint8_t getMaxOffset() const;
+    void draw();
+};
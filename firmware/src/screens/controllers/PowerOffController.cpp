@@ -61,7 +61,7 @@ void PowerOffController::performPowerOff() {
         DEBUG_PRINTLN("Temperature controller set to OFF");
  
         ctx->display->clearBuffer();
-        ctx->display->sendBuffer();
+        ctx->display->flush();
         DEBUG_PRINTLN("Display cleared");
 
         gpioOff(ctx->proofingLedPin);
@@ -4,7 +4,6 @@
 #include "../../AppContextDecl.h"
 
 // Forward declarations
-class IDisplayManager;
 class PowerOffView;
 class IInputManager;
 
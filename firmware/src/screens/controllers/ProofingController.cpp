@@ -3,11 +3,12 @@
 #include "../../icons.h"
 #include "../views/ProofingView.h"
 #include "../../ITemperatureController.h"
+#include <esp_timer.h>
 
 ProofingController::ProofingController(AppContext* ctx)
     : BaseController(ctx), _view(nullptr), _startTime(0),
       _lastTemperatureUpdate(0), _lastGraphUpdate(0), _previousDiffSeconds(0),
-      _temperatureController(nullptr)
+      _onGraph(false), _temperatureController(nullptr)
 {}
 
 void ProofingController::beginImpl() {
@@ -17,43 +18,77 @@ void ProofingController::beginImpl() {
     _temperatureController = ctx->tempController;
     _view = ctx->proofingView;
     
-    struct tm startTime;
-    getLocalTime(&startTime);
-    _startTime = mktime(&startTime);
+    _startTime = (time_t)(esp_timer_get_time() / 1000000ULL);
     getInputManager()->slowTemperaturePolling(false);
     _previousDiffSeconds = -60; // Force a redraw on the first update
+    _onGraph = false;
+    _chart.close();
 
     _temperatureController->setMode(ITemperatureController::HEATING);
-    _temperatureGraph.configure(30, 15, -5.0, 60.0, true);
+    _temperatureGraph.configure(30, 15, true);
     _view->start(getInputManager()->getTemperature(), _temperatureGraph);
 }
 
 bool ProofingController::update(bool shouldRedraw) {
     IInputManager* inputManager = getInputManager();
-    if (inputManager->isButtonPressed()) {
-        inputManager->slowTemperaturePolling(true);
-        _temperatureController->setMode(ITemperatureController::OFF);
-        _view->reset();
-        return false;
+    if (_chart.isOpen()) {
+        if (!_chart.handleInput(inputManager)) {
+            // Back from the chart: redraw the whole screen, the graph still selected
+            _view->start(inputManager->getTemperature(), _temperatureGraph);
+            _view->drawSelection(_onGraph, _temperatureGraph);
+            shouldRedraw = true;
+        }
+    } else {
+        if (inputManager->isButtonPressed()) {
+            if (_onGraph) {
+                _chart.open(getContext()->chartView, &_temperatureGraph, GRAPH_INTERVAL_SECONDS);
+                return true;
+            }
+            inputManager->slowTemperaturePolling(true);
+            _temperatureController->setMode(ITemperatureController::OFF);
+            _view->reset();
+            return false;
+        }
+        if (inputManager->getEncoderDirection() != IInputManager::EncoderDirection::None) {
+            _onGraph = !_onGraph;
+            _view->drawSelection(_onGraph, _temperatureGraph);
+            shouldRedraw = true;
+        }
     }
 
-    struct tm now;
-    getLocalTime(&now);
-    const time_t now_time = mktime(&now);
+    // Seconds since boot: unlike the wall clock, they do not jump when NTP sets the time
+    const time_t now_time = (time_t)(esp_timer_get_time() / 1000000ULL);
 
+    bool graphUpdated = false;
     if (difftime(now_time, _lastTemperatureUpdate) >= 1) {
         _lastTemperatureUpdate = now_time;
         const float currentTemp = inputManager->getTemperature();
-        _temperatureGraph.addValueToAverage(currentTemp);
-        shouldRedraw |= _view->drawTemperature(currentTemp);
+        // Relay state over the second that just ended, before update() switches it
+        const uint8_t relays = (_temperatureController->isHeating() ? Graph::HEATER : 0)
+                             | (_temperatureController->isCooling() ? Graph::COOLER : 0);
+        _temperatureGraph.addValueToAverage(currentTemp, relays);
         _temperatureController->update(currentTemp);
 
-        if (difftime(now_time, _lastGraphUpdate) >= 10) {
+        if (difftime(now_time, _lastGraphUpdate) >= GRAPH_INTERVAL_SECONDS) {
             _temperatureGraph.commitAverage(currentTemp);
             _lastGraphUpdate = now_time;
-            _view->drawGraph(_temperatureGraph);
-            shouldRedraw = true;
+            graphUpdated = true;
+        }
+        if (!_chart.isOpen()) {
+            shouldRedraw |= _view->drawTemperature(currentTemp);
+            if (graphUpdated) {
+                _view->drawGraph(_temperatureGraph);
+                shouldRedraw = true;
+            }
+        }
+    }
+
+    // Regulation carries on while the chart is shown, only the view is left alone
+    if (_chart.isOpen()) {
+        if (graphUpdated) {
+            _chart.onPointAdded();
         }
+        return true;
     }
 
     shouldRedraw |= _view->drawIcons(OptionalBool(_temperatureController->isHeating()));
@@ -3,6 +3,7 @@
 #include "../BaseController.h"
 #include "../../AppContextDecl.h"
 #include "../../Graph.h"
+#include "HistoryChart.h"
 
 // Forward
 class ProofingView;
@@ -16,11 +17,15 @@ public:
     bool update(bool forceRedraw = false) override;
 
 private:
+    static constexpr uint16_t GRAPH_INTERVAL_SECONDS = 10;
+
     ProofingView* _view;
-    time_t _startTime;
-    time_t _lastTemperatureUpdate;
-    time_t _lastGraphUpdate;
+    time_t _startTime;              // Seconds since boot
+    time_t _lastTemperatureUpdate;  // Seconds since boot
+    time_t _lastGraphUpdate;        // Seconds since boot
     time_t _previousDiffSeconds;
     Graph _temperatureGraph;
+    bool _onGraph;
+    HistoryChart _chart;
     ITemperatureController* _temperatureController;
 };
@@ -5,7 +5,6 @@
 #include "../../services/IRebootService.h"
 
 // Forward declarations
-class IDisplayManager;
 class RebootView;
 class IInputManager;
 
@@ -1,10 +1,11 @@
 #include "AdjustTimeView.h"
+#include "../../Fonts.h"
 
 void AdjustTimeView::drawTime(const SimpleTime& time, uint8_t valueY) {
-    _display->setFont(u8g2_font_ncenB18_tf);
+    _display->setFont(fonts::LARGE);
     char timeBuffer[6];
     sprintf(timeBuffer, "%02d:%02d", time.hours, time.minutes);
-    const uint8_t timeWidth = _display->getStrWidth("00:00");
+    const uint8_t timeWidth = _display->getNumericWidth("00:00");
     const uint8_t timeX = (_display->getDisplayWidth() - timeWidth) / 2;
     const uint8_t timeY = valueY + 2;
     const uint8_t clearWidth = _display->getWidth();
@@ -12,20 +13,20 @@ void AdjustTimeView::drawTime(const SimpleTime& time, uint8_t valueY) {
     _display->setDrawColor(0);
     _display->drawBox(timeX, timeY - _display->getAscent(), clearWidth, clearHeight);
     _display->setDrawColor(1);
-    _display->drawStr(timeX, timeY, timeBuffer);
+    _display->drawNumeric(timeX, timeY, timeBuffer);
     if(time.days > 0) {
-        _display->setFont(u8g2_font_ncenB12_tr);
+        _display->setFont(fonts::MEDIUM);
         sprintf(timeBuffer, "+%dj", time.days);
         _display->drawStr(timeX + timeWidth + 2, timeY - 4, timeBuffer);
     }
 }
 
 void AdjustTimeView::drawHighlight(uint8_t selectedItem, uint8_t valueY) {
-    _display->setFont(u8g2_font_ncenB18_tf);
-    const uint8_t timeWidth = _display->getStrWidth("00:00");
+    _display->setFont(fonts::LARGE);
+    const uint8_t timeWidth = _display->getNumericWidth("00:00");
     const uint8_t timeX = (_display->getDisplayWidth() - timeWidth) / 2;
     const uint8_t timeY = valueY + 2;
-    const uint8_t lineLength = _display->getStrWidth("00");
+    const uint8_t lineLength = _display->getNumericWidth("00");
     _display->setDrawColor(0);
     _display->drawBox(timeX, timeY + 2, timeWidth, 2);
     if (selectedItem == 0) {
@@ -33,7 +34,7 @@ void AdjustTimeView::drawHighlight(uint8_t selectedItem, uint8_t valueY) {
         _display->drawHLine(timeX, timeY + 2, lineLength);
     } else if (selectedItem == 1) {
         _display->setDrawColor(1);
-        _display->drawHLine(timeX + _display->getStrWidth("00:"), timeY + 2, lineLength);
+        _display->drawHLine(timeX + _display->getNumericWidth("00:"), timeY + 2, lineLength);
     }
 }
 
@@ -4,7 +4,7 @@
 
 class AdjustTimeView : public IBaseView {
 public:
-    explicit AdjustTimeView(DisplayManager* display) : IBaseView(display) {}
+    explicit AdjustTimeView(DisplayBackend* display) : IBaseView(display) {}
     void drawTime(const SimpleTime& time, uint8_t valueY);
     void drawHighlight(uint8_t selectedItem, uint8_t valueY);
     void drawButtons(const int8_t selectedButton);
@@ -1,14 +1,15 @@
 #include "AdjustValueView.h"
+#include "../../Fonts.h"
 
 bool AdjustValueView::drawValue(int value, uint8_t valueY) {
     if (value == _lastValueDrawn) {
         return false; // No change, skip redraw
     }
     _lastValueDrawn = value;
-    _display->setFont(u8g2_font_ncenB18_tf);
+    _display->setFont(fonts::LARGE);
     char buffer[6] = {'\0'};
     const uint8_t writtenChars = sprintf(buffer, "%d", value);
-    const uint8_t valueWidth = _display->getUTF8Width(buffer);
+    const uint8_t valueWidth = _display->getNumericWidth(buffer);
     buffer[writtenChars] = 0xC2;
     buffer[writtenChars+1] = 0xB0;
     const uint8_t valueX = (_display->getDisplayWidth() - valueWidth) / 2;
@@ -16,7 +17,7 @@ bool AdjustValueView::drawValue(int value, uint8_t valueY) {
     const uint8_t ascent = _display->getAscent();
     _display->drawBox(0, valueY - ascent, _display->getDisplayWidth(), ascent);
     _display->setDrawColor(1);
-    _display->drawStr(valueX, valueY, buffer);
+    _display->drawNumeric(valueX, valueY, buffer);
     return true;
 }
 
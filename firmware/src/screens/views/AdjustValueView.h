@@ -3,7 +3,7 @@
 
 class AdjustValueView : public IBaseView {
 public:
-    explicit AdjustValueView(DisplayManager* display) : IBaseView(display) {}
+    explicit AdjustValueView(DisplayBackend* display) : IBaseView(display) {}
     bool drawValue(int value, uint8_t valueY);
     void drawButtons();
     uint8_t start(const char* title, const int value);
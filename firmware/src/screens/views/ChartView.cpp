@@ -0,0 +1,118 @@
+#include "ChartView.h"
+#include "../../Fonts.h"
+
+void ChartView::reset() {
+    _scaleValid = false;
+}
+
+void ChartView::draw(const Graph& graph, uint8_t level, uint8_t pixelsPerPoint, uint8_t offset, uint32_t secondsPerPoint, bool panning) {
+    clear();
+    const uint8_t visiblePoints = getVisiblePoints(pixelsPerPoint);
+    // Ages of the points on screen, offset included, end excluded
+    const uint8_t end = min<uint16_t>(graph.getPointCount(level), offset + visiblePoints);
+    float minValue = INFINITY;
+    float maxValue = -INFINITY;
+    for (uint8_t age = offset; age < end; age++) {
+        if (graph.isPointValid(level, age)) {
+            const float value = graph.getPoint(level, age);
+            minValue = min(minValue, value);
+            maxValue = max(maxValue, value);
+        }
+    }
+    if (minValue <= maxValue) {
+        updateScale(minValue, maxValue);
+    }
+
+    _display->setDrawColor(1);
+    _display->drawVLine(PLOT_X - 1, 0, PLOT_HEIGHT + 1);
+    _display->drawHLine(PLOT_X - 1, PLOT_HEIGHT, PLOT_WIDTH + 1);
+
+    if (_scaleValid) {
+        setFont(fonts::REGULAR);
+        char label[10] = {'\0'};
+        snprintf(label, sizeof(label), "%d°", _high);
+        _display->drawNumeric(PLOT_X - 2 - _display->getNumericWidth(label), _display->getAscent(), label);
+        snprintf(label, sizeof(label), "%d°", _low);
+        _display->drawNumeric(PLOT_X - 2 - _display->getNumericWidth(label), CURVE_HEIGHT, label);
+
+        // Latest point on the right, each one joined to the next
+        const float scale = (CURVE_HEIGHT - 1) / static_cast<float>(_high - _low);
+        int16_t previousX = -1;
+        int16_t previousY = 0;
+        for (uint8_t age = offset; age < end; age++) {
+            if (!graph.isPointValid(level, age)) {
+                previousX = -1;
+                continue;
+            }
+            const int16_t x = PLOT_X + PLOT_WIDTH - 1 - (age - offset) * pixelsPerPoint;
+            const int16_t y = CURVE_HEIGHT - 1 - lroundf((graph.getPoint(level, age) - _low) * scale);
+            if (previousX < 0) {
+                _display->drawPixel(x, y);
+            } else {
+                _display->drawLine(x, y, previousX, previousY);
+            }
+            previousX = x;
+            previousY = y;
+        }
+    }
+    drawChannels(graph, level, pixelsPerPoint, offset, end);
+
+    drawFooter(offset, visiblePoints, secondsPerPoint, panning);
+}
+
+void ChartView::drawChannels(const Graph& graph, uint8_t level, uint8_t pixelsPerPoint, uint8_t offset, uint8_t end) {
+    // Each run of points with a channel on becomes one line, from the oldest point to the latest
+    for (uint8_t channel = 0; channel < Graph::CHANNEL_COUNT; channel++) {
+        const uint8_t y = STRIP_Y + channel;
+        int16_t runEnd = -1;
+        for (uint8_t age = offset; age <= end; age++) {
+            const bool on = age < end && (graph.getChannels(level, age) & (1 << channel));
+            const int16_t x = PLOT_X + PLOT_WIDTH - 1 - (age - offset) * pixelsPerPoint;
+            if (on && runEnd < 0) {
+                runEnd = x;
+            } else if (!on && runEnd >= 0) {
+                // x is the point after the run, so the run's oldest point is one step right of it
+                const int16_t runStart = x + pixelsPerPoint;
+                _display->drawHLine(runStart, y, runEnd - runStart + 1);
+                runEnd = -1;
+            }
+        }
+    }
+}
+
+void ChartView::updateScale(float minValue, float maxValue) {
+    int16_t low = floorf(minValue);
+    int16_t high = ceilf(maxValue);
+    if (high - low < MIN_SPAN) {
+        low -= (MIN_SPAN - (high - low)) / 2;
+        high = low + MIN_SPAN;
+    }
+    if (!_scaleValid || low < _low || high > _high || (high - low) * 2 < _high - _low) {
+        _low = low;
+        _high = high;
+        _scaleValid = true;
+    }
+}
+
+void ChartView::drawFooter(uint8_t offset, uint8_t visiblePoints, uint32_t secondsPerPoint, bool panning) {
+    char duration[10] = {'\0'};
+    char footer[24] = {'\0'};
+    if (panning) {
+        formatDuration(duration, sizeof(duration), offset * secondsPerPoint);
+        snprintf(footer, sizeof(footer), "D\xC3\xA9" "filer: -%s", duration);
+    } else {
+        formatDuration(duration, sizeof(duration), (visiblePoints - 1) * secondsPerPoint);
+        snprintf(footer, sizeof(footer), "Zoom: %s", duration);
+    }
+    setFont(fonts::REGULAR);
+    _display->drawUTF8(0, FOOTER_Y, footer);
+}
+
+void ChartView::formatDuration(char* buffer, size_t bufferSize, uint32_t seconds) {
+    const uint32_t minutes = seconds / 60;
+    if (minutes >= 60) {
+        snprintf(buffer, bufferSize, "%luh%02lu", (unsigned long)(minutes / 60), (unsigned long)(minutes % 60));
+    } else {
+        snprintf(buffer, bufferSize, "%lum", (unsigned long)minutes);
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "IBaseView.h"
+#include "../../Graph.h"
+
+// Full-screen temperature history, with a Y axis scaled to the points on screen and the relay
+// on-periods under it
+class ChartView : public IBaseView {
+public:
+    explicit ChartView(DisplayBackend* display) : IBaseView(display) {}
+    // Forget the current scale, before showing a new history
+    void reset();
+    // Draw the points of a history level from offset to offset + getVisiblePoints(), counted back
+    // from the latest one. The footer shows the span of the window when zooming, and its end when panning
+    void draw(const Graph& graph, uint8_t level, uint8_t pixelsPerPoint, uint8_t offset, uint32_t secondsPerPoint, bool panning);
+    // Points that fit on screen at a zoom level
+    static uint8_t getVisiblePoints(uint8_t pixelsPerPoint) { return (PLOT_WIDTH - 1) / pixelsPerPoint + 1; }
+
+private:
+    static constexpr uint8_t PLOT_X = 25;
+    static constexpr uint8_t PLOT_WIDTH = 103;
+    static constexpr uint8_t PLOT_HEIGHT = 52;
+    // One row per graph channel at the bottom of the plot, under the curve
+    static constexpr uint8_t STRIP_Y = PLOT_HEIGHT - Graph::CHANNEL_COUNT;
+    static constexpr uint8_t CURVE_HEIGHT = STRIP_Y - 1;
+    static constexpr uint8_t MIN_SPAN = 2; // °C
+    static constexpr uint8_t FOOTER_Y = 63;
+
+    // Scale in whole degrees; it only widens when points leave it, and only narrows when they use
+    // less than half of it, so it does not jump at every new point
+    int16_t _low = 0;
+    int16_t _high = 0;
+    bool _scaleValid = false;
+
+    void updateScale(float minValue, float maxValue);
+    void drawChannels(const Graph& graph, uint8_t level, uint8_t pixelsPerPoint, uint8_t offset, uint8_t end);
+    void drawFooter(uint8_t offset, uint8_t visiblePoints, uint32_t secondsPerPoint, bool panning);
+    static void formatDuration(char* buffer, size_t bufferSize, uint32_t seconds);
+};
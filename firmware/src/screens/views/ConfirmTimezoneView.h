@@ -3,7 +3,7 @@
 
 class ConfirmTimezoneView : public IBaseView {
 public:
-    explicit ConfirmTimezoneView(DisplayManager* display) : IBaseView(display) {}
+    explicit ConfirmTimezoneView(DisplayBackend* display) : IBaseView(display) {}
     void start();
     void setTimezone(const char* continentName, const char* timezoneName);
     void drawButtons(bool onCancelSelected);
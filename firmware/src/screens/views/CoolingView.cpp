@@ -1,15 +1,17 @@
 #include "CoolingView.h"
 #include "../../DebugUtils.h"
+#include "../../Fonts.h"
 #include "../../icons.h"
 
 #define GRAPH_POSITION_FROM_LEFT 30
+#define GRAPH_Y 34
 
-void CoolingView::start(const time_t endTime, bool onCancelSelected, Graph& graph) {
+void CoolingView::start(const time_t endTime, Selection selection, Graph& graph) {
     reset();
     clear();
     drawTitle(endTime);
-    drawButtons(onCancelSelected);
     drawGraph(graph);
+    drawSelection(selection, graph);
 }
 
 bool CoolingView::drawTime(const int remainingSeconds) {
@@ -19,7 +21,7 @@ bool CoolingView::drawTime(const int remainingSeconds) {
     _lastRemainingSeconds = remainingSeconds;
     char timeBuffer[17] = {0}; // "(dans 999h59m)"
     formatTimeString(timeBuffer, sizeof(timeBuffer), remainingSeconds);
-    _display->setFont(u8g2_font_t0_11_tf);
+    _display->setFont(fonts::REGULAR);
 
     const uint8_t timeX = 2;
     const uint8_t timeY = 42;
@@ -42,8 +44,8 @@ bool CoolingView::drawTemperature(const float currentTemp) {
     _lastTemperature = currentTemp;
     char tempBuffer[7] = {'\0'};
     snprintf(tempBuffer, sizeof(tempBuffer), "%.1f°", currentTemp);
-    _display->setFont(u8g2_font_t0_11_tf);
-    const uint8_t tempWidth = _display->getUTF8Width("99.9°");
+    _display->setFont(fonts::REGULAR);
+    const uint8_t tempWidth = _display->getNumericWidth("99.9°");
     const uint8_t tempHeight = _display->getAscent() - _display->getDescent();
     const uint8_t tempX = _display->getDisplayWidth() - tempWidth;
     const uint8_t tempY = 32;
@@ -52,7 +54,7 @@ bool CoolingView::drawTemperature(const float currentTemp) {
     _display->drawBox(tempX, tempY - _display->getAscent(), tempWidth, tempHeight);
     _display->setDrawColor(1);
 
-    _display->drawUTF8(tempX, tempY, tempBuffer);
+    _display->drawNumeric(tempX, tempY, tempBuffer);
     return true;
 }
 
@@ -76,7 +78,11 @@ bool CoolingView::drawIcons(OptionalBool iconState) {
 
 void CoolingView::drawGraph(Graph& graph) {
     _display->setDrawColor(1);
-    graph.draw(_display->getDisplay(), _display->getWidth() - GRAPH_POSITION_FROM_LEFT, 34);
+    const uint8_t graphX = _display->getWidth() - GRAPH_POSITION_FROM_LEFT;
+    graph.draw(_display, graphX, GRAPH_Y);
+    if (_graphSelected) {
+        graph.drawHighlight(_display, graphX, GRAPH_Y);
+    }
 }
 
 void CoolingView::formatTimeString(char* buffer, const size_t bufferSize, const int remainingSeconds) {
@@ -100,11 +106,17 @@ void CoolingView::reset() {
     _lastIconState = OptionalBool();
     _lastTemperature = -273.15; // Reset to ensure redraw
     _timeWidth = _display->getDisplayWidth(); // Reset to full width for first draw
+    _graphSelected = false;
 }
 
-void CoolingView::drawButtons(bool onCancelSelected) {
+void CoolingView::drawSelection(Selection selection, Graph& graph) {
     const char* buttons[] = {"Démarrer", "Annuler"};
-    IBaseView::drawButtons(buttons, 2, onCancelSelected ? 1 : 0);
+    IBaseView::drawButtons(buttons, 2, selection == Selection::Graph ? -1 : static_cast<int8_t>(selection));
+    const bool graphSelected = selection == Selection::Graph;
+    if (graphSelected != _graphSelected) {
+        _graphSelected = graphSelected;
+        graph.drawHighlight(_display, _display->getWidth() - GRAPH_POSITION_FROM_LEFT, GRAPH_Y);
+    }
 }
 
 void CoolingView::drawTitle(const time_t endTime) {
@@ -7,14 +7,23 @@
 
 class CoolingView : public IBaseView {
 public:
-    explicit CoolingView(DisplayManager* display): IBaseView(display) {};
+    // Selectable items, in encoder order; the graph opens the full-screen chart
+    enum class Selection : uint8_t {
+        Start,
+        Cancel,
+        Graph
+    };
+    static constexpr uint8_t SELECTION_COUNT = 3;
+
+    explicit CoolingView(DisplayBackend* display): IBaseView(display) {};
     bool drawTime(const int remainingSeconds);
     bool drawTemperature(const float currentTemp);
     bool drawIcons(OptionalBool iconState);
-    void drawButtons(bool onCancelSelected);
+    void drawSelection(Selection selection, Graph& graph);
     void drawGraph(Graph& graph);
-    void start(const time_t endTime, bool onCancelSelected, Graph& graph);
+    void start(const time_t endTime, Selection selection, Graph& graph);
 private:
+    bool _graphSelected = false;
     int _lastRemainingSeconds = -1;
     OptionalBool _lastIconState;
     float _lastTemperature = -273.15; // Initialize with a value below absolute zero to ensure first draw
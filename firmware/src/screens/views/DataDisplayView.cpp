@@ -1,4 +1,5 @@
 #include "DataDisplayView.h"
+#include "../../Fonts.h"
 
 void DataDisplayView::start() {
     reset();
@@ -19,10 +20,11 @@ void DataDisplayView::drawButtons() {
 void DataDisplayView::reset() {
     _lastTemperature = -273.15;
     _lastMinute = -1;
+    _lastEstimated = false;
 }
 
 void DataDisplayView::drawTimeZone(const char* timezone) {
-    _display->setFont(u8g2_font_t0_11_tf);
+    _display->setFont(fonts::REGULAR);
     const uint8_t screenWidth = _display->getDisplayWidth();
     const uint8_t tzY = 38;
     const uint8_t ascent = _display->getAscent();
@@ -48,7 +50,7 @@ bool DataDisplayView::drawTemperature(float temperatureC) {
     _lastTemperature = temperatureC;
     char tempBuffer[7] = {'\0'};
     snprintf(tempBuffer, sizeof(tempBuffer), "%.1f°C", temperatureC);
-    _display->setFont(u8g2_font_t0_11_tf);
+    _display->setFont(fonts::REGULAR);
     const uint8_t tempWidth = _display->getUTF8Width("99.9°C");
     const uint8_t tempHeight = _display->getAscent() - _display->getDescent();
     const uint8_t tempX = (_display->getDisplayWidth() - tempWidth) / 2;
@@ -62,26 +64,28 @@ bool DataDisplayView::drawTemperature(float temperatureC) {
     return true;
 }
 
-bool DataDisplayView::drawTime(const tm &now) {
-    if (_lastMinute == now.tm_min) {
+bool DataDisplayView::drawTime(const tm &now, bool estimated) {
+    if (_lastMinute == now.tm_min && _lastEstimated == estimated) {
         return false; // No change within the same minute
     }
-    char timeBuffer[15] = {0}; // "HH:MM DD/MM/YY"
-    snprintf(timeBuffer, sizeof(timeBuffer), "%02d:%02d %02d/%02d/%02d",
-             now.tm_hour, now.tm_min,
+    char timeBuffer[16] = {0}; // "~HH:MM DD/MM/YY"
+    snprintf(timeBuffer, sizeof(timeBuffer), "%s%02d:%02d %02d/%02d/%02d",
+             estimated ? "~" : "", now.tm_hour, now.tm_min,
              now.tm_mday, now.tm_mon + 1, now.tm_year % 100);
 
-    _display->setFont(u8g2_font_t0_11_tf);
+    _display->setFont(fonts::REGULAR);
     const uint8_t timeWidth = _display->getUTF8Width(timeBuffer);
     const uint8_t timeHeight = _display->getAscent() - _display->getDescent();
     const uint8_t timeX = (_display->getDisplayWidth() - timeWidth) / 2;
     const uint8_t timeY = 23;
 
+    // Clear the entire line, the '~' making the previous text wider
     _display->setDrawColor(0);
-    _display->drawBox(timeX, timeY - _display->getAscent(), timeWidth, timeHeight);
+    _display->drawBox(0, timeY - _display->getAscent(), _display->getDisplayWidth(), timeHeight);
     _display->setDrawColor(1);
 
     _display->drawUTF8(timeX, timeY, timeBuffer);
     _lastMinute = now.tm_min;
+    _lastEstimated = estimated;
     return true;
 }
@@ -4,16 +4,18 @@
 
 class DataDisplayView : public IBaseView {
 public:
-    explicit DataDisplayView(DisplayManager* display) : IBaseView(display) {}
+    explicit DataDisplayView(DisplayBackend* display) : IBaseView(display) {}
     void start();
     void reset();
     bool drawTemperature(float temperatureC);
-    bool drawTime(const tm &timeinfo);
+    // An estimated time, not confirmed by NTP yet, is shown with a leading '~'
+    bool drawTime(const tm &timeinfo, bool estimated = false);
     void drawButtons();
     void drawTimeZone(const char* timezone);
 private:
     void drawTitle();
     float _lastTemperature = -273.15;
     int _lastMinute = -1;
+    bool _lastEstimated = false;
 
 };
\ No newline at end of file
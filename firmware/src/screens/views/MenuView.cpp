@@ -0,0 +1,160 @@
+#include "MenuView.h"
+#include "../../Fonts.h"
+
+void MenuView::start() {
+    clear();
+
+    // Calculate all integer positions from screen center
+    // This must be done after display is available to get font metrics
+    const uint8_t displayHeight = _display->getDisplayHeight();  // 64 for SH1106
+    const int16_t screenCenterY = displayHeight / 2;  // 32
+
+    // Selection box center is at screen center
+    _selectionCenterY = screenCenterY;
+
+    // Set the font to get accurate font metrics
+    _display->setFont(fonts::REGULAR);
+
+    // Calculate text offset to center text vertically in the selection box
+    // Font metrics: ascent is pixels above baseline, descent is pixels below
+    const int8_t ascent = static_cast<int8_t>(_display->getAscent());
+    const int8_t descent = static_cast<int8_t>(_display->getDescent());
+
+    // Visual center of text is at: baseline - (ascent - descent) / 2
+    // To place visual center at selection center:
+    // baseline - (ascent - descent) / 2 = _selectionCenterY
+    // baseline = _selectionCenterY + (ascent - descent) / 2
+    // offset = baseline - _selectionCenterY = (ascent - descent) / 2
+    _menuItemYOffset = (ascent - descent) / 2;
+
+    // Calculate where displayIndex=0 should be positioned
+    // so that displayIndex=SELECTION_POSITION lands at the selection center
+    // Item at SELECTION_POSITION has baseline at: _selectionCenterY + _menuItemYOffset
+    // Working backwards: baseY + SELECTION_POSITION * MENU_ITEM_HEIGHT = _selectionCenterY + _menuItemYOffset
+    _itemBaseY = _selectionCenterY + _menuItemYOffset - SELECTION_POSITION * MENU_ITEM_HEIGHT;
+}
+
+void MenuView::draw(const MenuList& menu, uint16_t selectedIndex, int32_t scrollPosition, bool letterJump, const char* banner) {
+    _display->clearBuffer();
+    _display->setFontMode(1);
+    _display->setDrawColor(1);
+    _display->setBitmapMode(1);
+    _display->setFont(fonts::REGULAR); // Use a font that supports UTF-8
+
+    const uint16_t itemCount = menu.getCount();
+
+    // Split the scroll position into the item at the top (rounded down, also when negative) and
+    // the pixels it is scrolled past, always in range [0, MENU_ITEM_HEIGHT - 1]
+    const int32_t firstItem = scrollPosition >= 0
+        ? scrollPosition / SCROLL_UNIT
+        : -((SCROLL_UNIT - 1 - scrollPosition) / SCROLL_UNIT);
+    const int16_t scrollPixelOffset = static_cast<int16_t>((scrollPosition - firstItem * SCROLL_UNIT) * MENU_ITEM_HEIGHT / SCROLL_UNIT);
+
+    // Draw menu items without looping
+    // Show blank space above first item and below last item
+    // We always draw MAX_VISIBLE_ITEMS + 1 items to handle scrolling transitions
+    for (uint8_t displayIndex = 0; displayIndex <= MAX_VISIBLE_ITEMS; displayIndex++) {
+        // Calculate which menu item would be at this display position
+        const int32_t virtualIndex = firstItem + displayIndex;
+
+        // Calculate Y position: each display position has a fixed Y, then subtract scroll offset
+        // Item positions move uniformly as scrollPixelOffset increases
+        const int16_t yPos = static_cast<int16_t>(_itemBaseY + displayIndex * MENU_ITEM_HEIGHT - scrollPixelOffset);
+
+        // Only draw if virtualIndex is within valid menu range [0, menuSize-1]
+        // This creates blank space above item 0 and below last item
+        if (virtualIndex >= 0 && virtualIndex < itemCount) {
+            const uint16_t menuItemIndex = static_cast<uint16_t>(virtualIndex);
+
+            // Calculate the full extent of the item (icon top to text bottom with margins)
+            const int16_t itemTop = yPos + MENU_ICON_Y_OFFSET;  // Top of icon (yPos - 9)
+            const int16_t itemBottom = yPos + 4;  // Text bottom with margin for descenders
+
+            // Only draw if any part of the item is within visible bounds
+            // Allow a bit of clipping at the edges (1 pixel tolerance) for smoother transitions
+            if (itemBottom > -1 && itemTop < static_cast<int16_t>(_display->getDisplayHeight()) + 1) {
+                const MenuItem item = menu.getItem(menuItemIndex);
+                _display->drawUTF8(MENU_TEXT_X_OFFSET, yPos, item.name);
+                if (item.icon != nullptr) {
+                    _display->drawXBMP(MENU_ICON_X_OFFSET, yPos + MENU_ICON_Y_OFFSET, MENU_ICON_WIDTH, MENU_ICON_HEIGHT, item.icon);
+                }
+            }
+        }
+    }
+
+    // Draw selection highlight at FIXED position
+    // Selection box NEVER moves - items scroll past it
+    // The selection is always at the position calculated for displayIndex=SELECTION_POSITION with scrollPixelOffset=0
+    const int16_t selectionY = _itemBaseY + SELECTION_POSITION * MENU_ITEM_HEIGHT;
+    _display->setDrawColor(2);
+    _display->drawRBox(MENU_SELECTION_X_OFFSET, selectionY + MENU_SELECTION_Y_OFFSET, _display->getDisplayWidth() - 10, MENU_SELECTION_HEIGHT, MENU_SELECTION_RADIUS);
+    _display->setDrawColor(1);
+
+    drawScrollbar(itemCount, selectedIndex);
+    if (banner) {
+        drawBanner(banner);
+    }
+    if (letterJump) {
+        drawLetter(menu.getItem(selectedIndex).name);
+    }
+}
+
+void MenuView::drawScrollbar(const uint16_t itemCount, const uint16_t selectedIndex) {
+    // Only draw scrollbar if there are more items than can be displayed
+    if (itemCount <= MAX_VISIBLE_ITEMS) {
+        return;
+    }
+
+    const uint8_t displayHeight = _display->getDisplayHeight();
+    const uint8_t displayWidth = _display->getDisplayWidth();
+
+    // Calculate scrollbar dimensions
+    const uint8_t scrollbarTrackHeight = displayHeight - (2 * SCROLLBAR_Y_MARGIN);
+    // Use uint16_t to prevent overflow in multiplication before division
+    // Scrollbar height represents the proportion of visible items to total items
+    const uint16_t heightCalc = min(static_cast<uint16_t>(MAX_VISIBLE_ITEMS * scrollbarTrackHeight / itemCount), static_cast<uint16_t>(20));
+    const uint8_t scrollbarHeight = min(scrollbarTrackHeight, max(static_cast<uint8_t>(4), static_cast<uint8_t>(heightCalc)));
+
+    // Calculate scrollbar position based on the highlighted item
+    // Safety: itemCount > MAX_VISIBLE_ITEMS (>= 5), so (itemCount - 1) >= 4
+    const uint8_t maxScrollRange = scrollbarTrackHeight - scrollbarHeight;
+    const uint16_t posCalc = (uint16_t)selectedIndex * maxScrollRange / (itemCount - 1);
+    const uint8_t scrollbarY = SCROLLBAR_Y_MARGIN + (uint8_t)posCalc;
+
+    // Calculate X position (right side of display)
+    const uint8_t scrollbarX = displayWidth - SCROLLBAR_WIDTH - SCROLLBAR_X_OFFSET;
+
+    // Draw the scrollbar
+    _display->drawBox(scrollbarX, scrollbarY, SCROLLBAR_WIDTH, scrollbarHeight);
+    _display->drawVLine(scrollbarX + 1, SCROLLBAR_Y_MARGIN, scrollbarTrackHeight);
+}
+
+void MenuView::drawLetter(const char* name) {
+    // Initial of the selected item, which may take several UTF-8 bytes
+    char letter[5] = {};
+    uint8_t length = 0;
+    do {
+        letter[length] = name[length];
+        length++;
+    } while (length < sizeof(letter) - 1 && (name[length] & 0xC0) == 0x80);
+
+    // Boxed in the top right corner, left of the scrollbar
+    const uint8_t boxX = _display->getDisplayWidth() - 10 - LETTER_BOX_SIZE;
+    _display->setDrawColor(0);
+    _display->drawBox(boxX, 0, LETTER_BOX_SIZE, LETTER_BOX_SIZE);
+    _display->setDrawColor(1);
+    _display->drawFrame(boxX, 0, LETTER_BOX_SIZE, LETTER_BOX_SIZE);
+    const uint8_t letterX = boxX + (LETTER_BOX_SIZE - _display->getUTF8Width(letter) + 1) / 2;
+    _display->drawUTF8(letterX, LETTER_BOX_SIZE - 3, letter);
+}
+
+void MenuView::drawBanner(const char* text) {
+    // Inverted bar over the top row, which is mostly scrolled out of view
+    const uint8_t width = _display->getDisplayWidth();
+    const uint8_t textWidth = _display->getUTF8Width(text);
+    _display->setDrawColor(1);
+    _display->drawBox(0, 0, width, BANNER_HEIGHT);
+    _display->setDrawColor(0);
+    _display->drawUTF8(textWidth < width ? (width - textWidth) / 2 : 0, BANNER_HEIGHT - 2, text);
+    _display->setDrawColor(1);
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include "IBaseView.h"
+#include "../MenuList.h"
+
+// The menu screen: the items around a scroll position, with the selection box at a fixed row.
+// Menu owns the navigation and the scroll animation, and hands the state of each frame here.
+class MenuView : public IBaseView {
+public:
+    explicit MenuView(DisplayBackend* display) : IBaseView(display) {}
+
+    // Clear the screen and measure the font; call before the first draw()
+    void start();
+    // scrollPosition is in 1/SCROLL_UNIT of an item from item 0 at the top (negative when the
+    // first items sit below the top). letterJump boxes the initial of the selected item in the
+    // corner, and a banner, if any, covers the top row.
+    void draw(const MenuList& menu, uint16_t selectedIndex, int32_t scrollPosition, bool letterJump, const char* banner);
+
+    static constexpr int32_t SCROLL_UNIT = 256;  // Fixed-point scale of the scroll position
+    static const uint8_t MAX_VISIBLE_ITEMS = 4;
+    static const uint8_t SELECTION_POSITION = 2;  // Fixed position where selection is drawn (0-3, 2 = centered/third from top)
+
+private:
+    static const uint8_t MENU_ITEM_HEIGHT = 16;
+    static const uint8_t MENU_ICON_X_OFFSET = 3;
+    static const int8_t MENU_ICON_Y_OFFSET = -9;
+    static const uint8_t MENU_ICON_WIDTH = 10;
+    static const uint8_t MENU_ICON_HEIGHT = 10;
+    static const uint8_t MENU_TEXT_X_OFFSET = 16;
+    static const uint8_t MENU_SELECTION_X_OFFSET = 0;
+    static const int8_t MENU_SELECTION_Y_OFFSET = -12;
+    static const uint8_t MENU_SELECTION_HEIGHT = 15;
+    static const uint8_t MENU_SELECTION_RADIUS = 1;
+
+    static const uint8_t SCROLLBAR_WIDTH = 3;
+    static const uint8_t SCROLLBAR_X_OFFSET = 2;
+    static const uint8_t SCROLLBAR_Y_MARGIN = 2;
+
+    // Initial shown in the corner in letter jump mode
+    static const uint8_t LETTER_BOX_SIZE = 13;
+    static const uint8_t BANNER_HEIGHT = 11;
+
+    // Pre-calculated integer positions (set in start())
+    int16_t _selectionCenterY = 0;  // Y coordinate of selection box center
+    int16_t _itemBaseY = 0;  // Base Y position for menu items (where displayIndex=0 would be)
+    int8_t _menuItemYOffset = 0;  // Calculated offset to center text vertically (font baseline adjustment)
+
+    void drawScrollbar(uint16_t itemCount, uint16_t selectedIndex);
+    void drawLetter(const char* name);
+    void drawBanner(const char* text);
+};
@@ -3,7 +3,7 @@
 
 class PowerOffView : public IBaseView {
 public:
-    explicit PowerOffView(DisplayManager* display) : IBaseView(display) {}
+    explicit PowerOffView(DisplayBackend* display) : IBaseView(display) {}
     void start();
     void drawButtons(bool onCancelSelected);
 };
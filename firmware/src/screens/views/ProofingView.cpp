@@ -1,23 +1,33 @@
 #include "ProofingView.h"
 #include "../../DebugUtils.h"
+#include "../../Fonts.h"
 #include "../../icons.h"
 
 void ProofingView::start(float currentTemp, Graph& graph) {
     reset();
     clear();
     drawTitle("En pousse depuis");
-    const char* buttons[] = {"Annuler"};
-    drawButtons(buttons, 1, 0);
     drawTemperature(currentTemp);
     drawTime(0);
+    drawSelection(false, graph);
     drawGraph(graph);
 }
 
+void ProofingView::drawSelection(bool onGraphSelected, Graph& graph) {
+    const char* buttons[] = {"Annuler"};
+    drawButtons(buttons, 1, onGraphSelected ? -1 : 0);
+    if (onGraphSelected != _graphSelected) {
+        _graphSelected = onGraphSelected;
+        graph.drawHighlight(_display, graphX(), GRAPH_Y);
+    }
+}
+
 bool ProofingView::drawTime(const time_t diffSeconds) {
     if (diffSeconds - _lastTimeDrawn < 60) {
         return false; // No change, skip redraw
     }
-    _lastTimeDrawn = diffSeconds;
+    // Keep to whole minutes of the run, even when the screen is redrawn mid-minute
+    _lastTimeDrawn = diffSeconds - diffSeconds % 60;
     const int total_minutes = diffSeconds / 60;
     const int hours = total_minutes / 60;
     const int minutes = total_minutes % 60;
@@ -28,9 +38,9 @@ bool ProofingView::drawTime(const time_t diffSeconds) {
     } else {
         snprintf(timeBuffer, sizeof(timeBuffer), "%dm", minutes);
     }
-    setFont(u8g2_font_ncenB18_tf);
+    setFont(fonts::LARGE);
 
-    const uint8_t timeWidth = _display->getStrWidth(timeBuffer);
+    const uint8_t timeWidth = _display->getNumericWidth(timeBuffer);
     const uint8_t timeX = (_display->getDisplayWidth() - timeWidth) / 2;
     const uint8_t timeY = 36;
     const uint8_t fontHeight = _display->getAscent() - _display->getDescent();
@@ -39,7 +49,7 @@ bool ProofingView::drawTime(const time_t diffSeconds) {
     _display->drawBox(timeX, timeY - _display->getAscent(), timeWidth, fontHeight);
 
     _display->setDrawColor(1);
-    _display->drawUTF8(timeX, timeY, timeBuffer);
+    _display->drawNumeric(timeX, timeY, timeBuffer);
     return true;
 }
 
@@ -51,8 +61,8 @@ bool ProofingView::drawTemperature(const float currentTemp) {
     char tempBuffer[7] = {'\0'};
     snprintf(tempBuffer, sizeof(tempBuffer), "%.1f°", currentTemp);
 
-    setFont(u8g2_font_t0_11_tf);
-    const uint8_t tempWidth = _display->getUTF8Width("99.9°");
+    setFont(fonts::REGULAR);
+    const uint8_t tempWidth = _display->getNumericWidth("99.9°");
     const uint8_t tempHeight = _display->getAscent() - _display->getDescent();
     const uint8_t tempX = _display->getDisplayWidth() - tempWidth;
     const uint8_t tempY = 44;
@@ -61,7 +71,7 @@ bool ProofingView::drawTemperature(const float currentTemp) {
     _display->drawBox(tempX, tempY - _display->getAscent(), tempWidth, tempHeight);
     _display->setDrawColor(1);
 
-    _display->drawUTF8(tempX, tempY, tempBuffer);
+    _display->drawNumeric(tempX, tempY, tempBuffer);
     return true;
 }
 
@@ -87,11 +97,15 @@ bool ProofingView::drawIcons(OptionalBool iconState) {
 
 void ProofingView::drawGraph(Graph& graph) {
     _display->setDrawColor(1);
-    graph.draw(_display->getDisplay(), _display->getWidth() - 30, 48);
+    graph.draw(_display, graphX(), GRAPH_Y);
+    if (_graphSelected) {
+        graph.drawHighlight(_display, graphX(), GRAPH_Y);
+    }
 }
 
 void ProofingView::reset() {
     _lastTempDrawn = -257.0;
     _lastIconState = OptionalBool();
     _lastTimeDrawn = -1000;
+    _graphSelected = false;
 }
\ No newline at end of file
@@ -6,15 +6,20 @@
 
 class ProofingView : public IBaseView {
 public:
-    explicit ProofingView(DisplayManager* display) : IBaseView(display) {}
+    explicit ProofingView(DisplayBackend* display) : IBaseView(display) {}
     bool drawTime(const time_t diffSeconds);
     bool drawTemperature(const float currentTemp);
     bool drawIcons(OptionalBool iconState);
+    // Highlights either the cancel button or the graph, which opens the full-screen chart
+    void drawSelection(bool onGraphSelected, Graph& graph);
     void drawGraph(Graph& graph);
     void reset();
     void start(float currentTemp, Graph& graph);
 private:
+    static constexpr uint8_t GRAPH_Y = 48;
+    bool _graphSelected = false;
     float _lastTempDrawn = -257.0;
     OptionalBool _lastIconState;
     time_t _lastTimeDrawn = -1000;
+    uint8_t graphX() const { return _display->getWidth() - 30; }
 };
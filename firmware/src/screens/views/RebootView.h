@@ -3,7 +3,7 @@
 
 class RebootView : public IBaseView {
 public:
-    explicit RebootView(DisplayManager* display) : IBaseView(display) {}
+    explicit RebootView(DisplayBackend* display) : IBaseView(display) {}
     void start();
     void drawButtons(bool onCancelSelected);
 };
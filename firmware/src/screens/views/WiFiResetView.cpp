@@ -1,4 +1,5 @@
 #include "WiFiResetView.h"
+#include "../../Fonts.h"
 #include "../../icons.h"
 
 
@@ -10,8 +11,9 @@ void WiFiResetView::start() {
 
 void WiFiResetView::showResetMessage() {
     clear();
-    setFont(u8g2_font_t0_11_tf);
+    setFont(fonts::REGULAR);
     const uint8_t titleHeight = _display->getDisplayHeight() / 2 - _display->getAscent();
     drawTitle("Reset du Wi-Fi\n" "et red\xC3\xA9marrage...", titleHeight);
-    sendBuffer();
+    // The controller blocks until the reboot, so the frame cannot wait for the next update()
+    flush();
 }
@@ -3,7 +3,7 @@
 
 class WiFiResetView : public IBaseView {
 public:
-    explicit WiFiResetView(DisplayManager* display) : IBaseView(display) {}
+    explicit WiFiResetView(DisplayBackend* display) : IBaseView(display) {}
     void showResetMessage();
     void start();
 };
@@ -1,14 +1,52 @@
 #pragma once
 #include <stdint.h>
-#include <functional>
 
 namespace services {
     struct INetworkService {
+        // Earlier times are the clock counting from boot, before NTP set it
+        static const uint32_t TIME_SYNC_THRESHOLD = 1000000000;
+
+        enum class State : uint8_t {
+            Idle,        // begin() not called yet
+            Connecting,  // Joining the saved WiFi network
+            Portal,      // Captive portal open, waiting for the user to enter credentials
+            Connected,   // NTP started, the time is set in the background
+            Offline      // Gave up; connects later if the saved network comes back
+        };
+
+        // Where the wall clock comes from
+        enum class TimeSource : uint8_t {
+            None,      // Counting from boot, until NTP sets it
+            Storage,   // Saved before a power cut: behind by the time the device was off
+            Retained,  // Kept through deep sleep or a reset, within seconds
+            Ntp        // Confirmed by NTP
+        };
+
         virtual ~INetworkService() {}
-        virtual bool autoConnect(const char* portalSsid = nullptr,
-                     std::function<void(const char* apName)> onPortalStarted = nullptr) = 0;
+        // Start bringing the network up without blocking; update() advances it from loop()
+        virtual void begin(const char* portalSsid) = 0;
+        virtual void update() = 0;
+        virtual State getState() const = 0;
+        // Network to join to enter the WiFi credentials, while getState() is Portal
+        virtual const char* getPortalSsid() const = 0;
         virtual void resetSettings() = 0;
+        // Applied once connected, and to local time right away. The strings must stay valid.
         virtual void configureNtp(const char* timezone, const char* server1, const char* server2) = 0;
+        // True once NTP has set the clock past threshold
         virtual bool isTimeSyncReady(uint32_t threshold) = 0;
+        virtual TimeSource getTimeSource() const = 0;
+        // True while the clock runs from the last known time saved before a reboot, until NTP confirms it
+        bool isTimeEstimated() const {
+            return getTimeSource() == TimeSource::Storage || getTimeSource() == TimeSource::Retained;
+        }
+        // Whether the wall clock can be used at all, even estimated
+        bool isTimeKnown() {
+            return isTimeSyncReady(TIME_SYNC_THRESHOLD) || isTimeEstimated();
+        }
+        // Whether the wall clock is close enough to schedule something at a time of day, which a
+        // time restored after a power cut is not
+        bool isTimeReliable() {
+            return isTimeSyncReady(TIME_SYNC_THRESHOLD) || getTimeSource() == TimeSource::Retained;
+        }
     };
 }
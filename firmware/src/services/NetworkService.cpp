@@ -1,45 +1,183 @@
 #include "NetworkService.h"
+#include "DebugUtils.h"
+#include "IStorage.h"
+#include "StorageConstants.h"
 #include <WiFiManager.h>
 #include <WiFi.h>
+#include <esp_attr.h>
+#include <esp_sntp.h>
+#include <esp_timer.h>
+#include <stdlib.h>
+#include <sys/time.h>
 #include <time.h>
 
 namespace services {
 
-bool NetworkService::autoConnect(const char* portalSsid,
-                                 std::function<void(const char* apName)> onPortalStarted) {
+namespace {
+    // Kept across update() calls, which serve its captive portal
     WiFiManager wifiManager;
+
+    constexpr uint32_t CONNECT_TIMEOUT_MS = 20000;  // To join the saved network before opening the portal
+    constexpr int PORTAL_TIMEOUT_S = 180;           // Long enough for user input, then give up; the menu works meanwhile
+
+    constexpr uint32_t CLOCK_SAVE_INTERVAL_MS = 15 * 60 * 1000;  // To storage, sparing the flash
+
+    // Last known wall clock, kept in RTC memory through deep sleep and software resets. It is
+    // not initialized at boot, so the magic number tells a saved clock from a power-on one.
+    struct RtcClock {
+        uint32_t magic;
+        uint32_t epoch;
+    };
+    constexpr uint32_t RTC_CLOCK_MAGIC = 0x434c4b31;  // "CLK1"
+    RTC_NOINIT_ATTR RtcClock rtcClock;
+
+    // Set from the SNTP task
+    volatile bool timeSynced = false;
+
+    void onTimeSynced(struct timeval*) {
+        timeSynced = true;
+    }
+
+    uint32_t nowMs() {
+        return (uint32_t)(esp_timer_get_time() / 1000ULL);
+    }
+}
+
+void NetworkService::begin(const char* portalSsid) {
+    _portalSsid = portalSsid;
+    sntp_set_time_sync_notification_cb(onTimeSynced);
+    restoreClock();
     // Make reconnection more reliable and give the user enough time to enter credentials
     WiFi.setAutoReconnect(true);
     WiFi.persistent(true);
-    wifiManager.setCleanConnect(true);          // forget any half-open connection attempts
-    wifiManager.setConnectTimeout(20);          // seconds to wait for WiFi association
-    wifiManager.setConfigPortalTimeout(60);     // keep portal up long enough for user input without hanging too long
+    wifiManager.setConfigPortalBlocking(false);
+    wifiManager.setConfigPortalTimeout(PORTAL_TIMEOUT_S);
     wifiManager.setWiFiAutoReconnect(true);
     wifiManager.setBreakAfterConfig(true);      // exit once credentials are saved (even if connect fails now)
-    if (onPortalStarted) {
-        wifiManager.setAPCallback([onPortalStarted](WiFiManager* wm) {
-            String apName = wm ? wm->getConfigPortalSSID() : String("ConfigPortal");
-            IPAddress apIp = WiFi.softAPIP();
-            onPortalStarted(apName.c_str());
-        });
+    if (!wifiManager.getWiFiIsSaved()) {
+        startPortal();
+        return;
+    }
+    WiFi.mode(WIFI_STA);
+    WiFi.begin();  // With the saved credentials
+    _state = State::Connecting;
+    _stateSince = nowMs();
+    DEBUG_PRINTLN("Connecting to the saved WiFi network");
+}
+
+void NetworkService::update() {
+    if (timeSynced && _timeSource != TimeSource::Ntp) {
+        _timeSource = TimeSource::Ntp;
+        _clockSavedAt = nowMs() - CLOCK_SAVE_INTERVAL_MS;  // Save the confirmed clock right away
+        DEBUG_PRINTLN("Time synchronized");
+    }
+    saveClock();
+
+    switch (_state) {
+        case State::Connecting:
+            if (WiFi.status() == WL_CONNECTED) {
+                onConnected();
+            } else if (nowMs() - _stateSince > CONNECT_TIMEOUT_MS) {
+                startPortal();
+            }
+            break;
+        case State::Portal:
+            // process() serves the portal, and is true once the credentials entered connected
+            if (wifiManager.process()) {
+                onConnected();
+            } else if (!wifiManager.getConfigPortalActive()) {
+                _state = State::Offline;
+                DEBUG_PRINTLN("WiFi unavailable, continuing offline");
+            }
+            break;
+        case State::Offline:
+            if (WiFi.status() == WL_CONNECTED) {
+                onConnected();
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void NetworkService::startPortal() {
+    if (_portalSsid && _portalSsid[0] != '\0') {
+        wifiManager.startConfigPortal(_portalSsid);
+    } else {
+        wifiManager.startConfigPortal();
     }
-    if (portalSsid && portalSsid[0] != '\0') {
-        return wifiManager.autoConnect(portalSsid);
+    _state = State::Portal;
+    _stateSince = nowMs();
+    DEBUG_PRINTLN("WiFi portal started");
+}
+
+void NetworkService::onConnected() {
+    _state = State::Connected;
+    if (_timezone) {
+        configTzTime(_timezone, _ntpServer1, _ntpServer2);
     }
-    return wifiManager.autoConnect();
+    DEBUG_PRINTLN("WiFi connected, NTP started");
 }
 
 void NetworkService::resetSettings() {
-    WiFiManager wifiManager;
     wifiManager.resetSettings();
 }
 
 void NetworkService::configureNtp(const char* timezone, const char* server1, const char* server2) {
-    configTzTime(timezone, server1, server2);
+    _timezone = timezone;
+    _ntpServer1 = server1;
+    _ntpServer2 = server2;
+    if (_state == State::Connected) {
+        configTzTime(timezone, server1, server2);
+    } else {
+        // NTP needs the network, but local time can follow the timezone already
+        setenv("TZ", timezone, 1);
+        tzset();
+    }
 }
 
 bool NetworkService::isTimeSyncReady(uint32_t threshold) {
-    return time(nullptr) >= (time_t)threshold;
+    return timeSynced && time(nullptr) >= (time_t)threshold;
+}
+
+void NetworkService::restoreClock() {
+    // The system clock itself goes on through deep sleep and software resets
+    time_t restored = time(nullptr);
+    TimeSource source = TimeSource::Retained;
+    if (restored < (time_t)TIME_SYNC_THRESHOLD && rtcClock.magic == RTC_CLOCK_MAGIC) {
+        restored = rtcClock.epoch;
+    }
+    // After a power cut, the time saved to storage is all there is. It lags behind by the time
+    // the device was off, and up to CLOCK_SAVE_INTERVAL_MS, but beats starting from 1970.
+    if (restored < (time_t)TIME_SYNC_THRESHOLD && _storage) {
+        restored = (uint32_t)_storage->getInt(storage::keys::CLOCK_KEY, 0);
+        source = TimeSource::Storage;
+    }
+    if (restored < (time_t)TIME_SYNC_THRESHOLD) {
+        DEBUG_PRINTLN("No saved time, waiting for NTP");
+        return;
+    }
+    if (time(nullptr) < restored) {
+        struct timeval tv = { restored, 0 };
+        settimeofday(&tv, nullptr);
+    }
+    _timeSource = source;
+    _clockSavedAt = nowMs();
+    DEBUG_PRINTLN("Time restored, estimated until NTP confirms it");
+}
+
+void NetworkService::saveClock() {
+    const time_t now = time(nullptr);
+    if (now < (time_t)TIME_SYNC_THRESHOLD) {
+        return;
+    }
+    // RTC memory is plain RAM: keep it current
+    rtcClock.epoch = (uint32_t)now;
+    rtcClock.magic = RTC_CLOCK_MAGIC;
+    if (_storage && nowMs() - _clockSavedAt >= CLOCK_SAVE_INTERVAL_MS) {
+        _storage->setInt(storage::keys::CLOCK_KEY, (int)(uint32_t)now);
+        _clockSavedAt = nowMs();
+    }
 }
 
 } // namespace services
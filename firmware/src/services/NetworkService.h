@@ -1,12 +1,34 @@
 #pragma once
 #include "INetworkService.h"
+#include "IStorage.h"
 
 namespace services {
     struct NetworkService : public INetworkService {
-        bool autoConnect(const char* portalSsid = nullptr,
-                 std::function<void(const char* apName)> onPortalStarted = nullptr) override;
+        // Saves the clock across power cuts; without it, only reboots keep it
+        void setStorage(IStorage* storage) { _storage = storage; }
+        void begin(const char* portalSsid) override;
+        void update() override;
+        State getState() const override { return _state; }
+        const char* getPortalSsid() const override { return _portalSsid; }
         void resetSettings() override;
         void configureNtp(const char* timezone, const char* server1, const char* server2) override;
         bool isTimeSyncReady(uint32_t threshold) override;
+        TimeSource getTimeSource() const override { return _timeSource; }
+
+    private:
+        void startPortal();
+        void onConnected();
+        void restoreClock();
+        void saveClock();
+
+        State _state = State::Idle;
+        uint32_t _stateSince = 0;  // Milliseconds since boot when _state was entered
+        const char* _portalSsid = nullptr;
+        const char* _timezone = nullptr;
+        const char* _ntpServer1 = nullptr;
+        const char* _ntpServer2 = nullptr;
+        IStorage* _storage = nullptr;
+        TimeSource _timeSource = TimeSource::None;
+        uint32_t _clockSavedAt = 0;  // Milliseconds since boot when the clock was last saved to storage
     };
 }
@@ -0,0 +1,252 @@
+#!/usr/bin/env python3
+"""
+Generate FontSubsets.h from the U8g2 font sources
+Keeps only the glyphs the UI can display, which shrinks flash and shortens
+U8g2's linear glyph lookup
+"""
+
+import argparse
+import glob
+import hashlib
+import os
+import re
+from datetime import datetime
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+PROJECT_DIR = os.path.normpath(os.path.join(SCRIPT_DIR, '..'))
+SRC_DIR = os.path.join(PROJECT_DIR, 'src')
+OUTPUT_FILE = os.path.join(SRC_DIR, 'FontSubsets.h')
+DEFAULT_LIBDEPS_DIR = os.path.join(PROJECT_DIR, '.pio', 'libdeps')
+FONTS_SOURCE = os.path.join('U8g2', 'src', 'clib', 'u8g2_fonts.c')
+
+# Size of the U8g2 font header, and the offsets of the fields the subset has to rewrite
+HEADER_SIZE = 23
+GLYPH_COUNT_OFFSET = 0
+UPPER_A_OFFSET = 17
+LOWER_A_OFFSET = 19
+UNICODE_OFFSET = 21
+
+PRINTABLE_ASCII = ''.join(chr(c) for c in range(0x20, 0x7F))
+# Characters the glyph cache decodes for numeric readouts (see GlyphCache.cpp)
+NUMERIC = ' 0123456789.-:hm°'
+
+# Subset name -> U8g2 font, fixed characters, and whether to add the non-ASCII
+# characters found in the source string literals
+SUBSETS = [
+    # Menus, titles and dynamic text (IP addresses, SSIDs) all use the regular font
+    ('REGULAR', 'u8g2_font_t0_11_tf', PRINTABLE_ASCII, True),
+    # Temperatures, durations and times
+    ('LARGE', 'u8g2_font_ncenB18_tf', NUMERIC, False),
+    # Day offset next to the time ("+1j")
+    ('MEDIUM', 'u8g2_font_ncenB12_tr', ' +0123456789j', False),
+]
+
+STRING_LITERAL = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+C_ESCAPES = {'n': 10, 't': 9, 'r': 13, '0': 0, '\\': 92, '"': 34, "'": 39, '?': 63}
+
+
+def find_fonts_source(libdeps_dir):
+    """Find u8g2_fonts.c among the installed PlatformIO libraries"""
+    matches = sorted(glob.glob(os.path.join(libdeps_dir, '*', FONTS_SOURCE)))
+    return matches[0] if matches else None
+
+
+def decode_c_string(literal):
+    """Decode the body of a C string literal into bytes"""
+    data = bytearray()
+    i = 0
+    while i < len(literal):
+        c = literal[i]
+        if c != '\\':
+            data.extend(c.encode('utf-8'))
+            i += 1
+            continue
+        nxt = literal[i + 1]
+        if nxt == 'x':
+            match = re.match(r'[0-9a-fA-F]+', literal[i + 2:])
+            data.append(int(match.group(0), 16) & 0xFF)
+            i += 2 + len(match.group(0))
+        elif nxt in '01234567':
+            match = re.match(r'[0-7]{1,3}', literal[i + 1:])
+            data.append(int(match.group(0), 8) & 0xFF)
+            i += 1 + len(match.group(0))
+        else:
+            data.append(C_ESCAPES.get(nxt, ord(nxt)))
+            i += 2
+    return bytes(data)
+
+
+def scan_ui_characters():
+    """Collect the Latin-1 characters used in string literals across src/"""
+    characters = set()
+    for pattern in ('**/*.cpp', '**/*.h'):
+        for path in glob.glob(os.path.join(SRC_DIR, pattern), recursive=True):
+            if os.path.abspath(path) == os.path.abspath(OUTPUT_FILE):
+                continue
+            with open(path, 'r', encoding='utf-8', errors='ignore') as f:
+                content = f.read()
+            for literal in STRING_LITERAL.findall(content):
+                text = decode_c_string(literal).decode('utf-8', errors='ignore')
+                characters.update(c for c in text if 0x80 <= ord(c) <= 0xFF)
+    return ''.join(sorted(characters))
+
+
+def read_font(source, name):
+    """Extract the bytes of one font from u8g2_fonts.c"""
+    # The font data is a sequence of string literals, which may themselves contain ';'
+    match = re.search(r'const\s+uint8_t\s+' + re.escape(name) + r'\[\d+\][^=]*=((?:\s*"(?:[^"\\\n]|\\.)*")+)\s*;', source)
+    if not match:
+        raise ValueError(f'Font {name} not found')
+    literals = STRING_LITERAL.findall(match.group(1))
+    # The array size includes the terminating NUL of the string literal
+    return b''.join(decode_c_string(literal) for literal in literals) + b'\0'
+
+
+def subset_font(font, characters):
+    """Keep the 8-bit glyphs listed in characters; returns (data, kept, total)"""
+    encodings = {ord(c) for c in characters if ord(c) <= 0xFF}
+    header = bytearray(font[:HEADER_SIZE])
+    glyphs = bytearray()
+    upper_a = lower_a = None
+    kept = total = 0
+
+    # 8-bit glyphs are [encoding, size, data...] records, sorted by encoding, ended by a zero size
+    pos = HEADER_SIZE
+    while font[pos + 1] != 0:
+        encoding, size = font[pos], font[pos + 1]
+        total += 1
+        if encoding in encodings:
+            if upper_a is None and encoding >= ord('A'):
+                upper_a = len(glyphs)
+            if lower_a is None and encoding >= ord('a'):
+                lower_a = len(glyphs)
+            glyphs.extend(font[pos:pos + size])
+            kept += 1
+        pos += size
+
+    # The terminator and the unicode section are copied unchanged, only their offset moves
+    tail_start = len(glyphs)
+    unicode_start = int.from_bytes(font[UNICODE_OFFSET:UNICODE_OFFSET + 2], 'big')
+    unicode_shift = (pos - HEADER_SIZE) - tail_start
+    glyphs.extend(font[pos:])
+
+    # Lookups for missing letters start at the terminator and fail straight away
+    header[GLYPH_COUNT_OFFSET] = kept
+    header[UPPER_A_OFFSET:UPPER_A_OFFSET + 2] = (tail_start if upper_a is None else upper_a).to_bytes(2, 'big')
+    header[LOWER_A_OFFSET:LOWER_A_OFFSET + 2] = (tail_start if lower_a is None else lower_a).to_bytes(2, 'big')
+    header[UNICODE_OFFSET:UNICODE_OFFSET + 2] = (unicode_start - unicode_shift).to_bytes(2, 'big')
+    return bytes(header + glyphs), kept, total
+
+
+def get_input_hash(fonts_source, charsets):
+    """Hash of everything the output depends on"""
+    sha256_hash = hashlib.sha256()
+    if fonts_source:
+        with open(fonts_source, 'rb') as f:
+            sha256_hash.update(f.read())
+    else:
+        sha256_hash.update(b'no font source')
+    for name, charset in charsets:
+        sha256_hash.update(name.encode('utf-8') + charset.encode('utf-8'))
+    return sha256_hash.hexdigest()
+
+
+def parse_hash_from_existing(file_path):
+    """Parse the input hash from an existing FontSubsets.h if it exists"""
+    if not os.path.exists(file_path):
+        return None
+    with open(file_path, 'r', encoding='utf-8') as f:
+        for line in f.readlines()[:20]:
+            if '// Input hash:' in line:
+                return line.split(':', 1)[1].strip()
+    return None
+
+
+def format_bytes(data, indent):
+    lines = []
+    for start in range(0, len(data), 16):
+        lines.append(indent + ', '.join(f'0x{b:02x}' for b in data[start:start + 16]) + ',')
+    return lines
+
+
+def generate_header(fonts_source, charsets, input_hash):
+    timestamp = datetime.now().strftime('%Y-%m-%d %H:%M:%S UTC')
+    source = None
+    if fonts_source:
+        with open(fonts_source, 'r', encoding='utf-8', errors='ignore') as f:
+            source = f.read()
+
+    header = []
+    header.append('#pragma once')
+    header.append('')
+    header.append('// ============================================================================')
+    header.append('// AUTO-GENERATED FILE - DO NOT EDIT')
+    header.append('// ============================================================================')
+    header.append('//')
+    header.append(f'// Generated from: {os.path.relpath(fonts_source, PROJECT_DIR) if fonts_source else "U8g2 not installed, using full fonts"}')
+    header.append(f'// Input hash: {input_hash}')
+    header.append(f'// Generated at: {timestamp}')
+    header.append('//')
+    header.append('// To regenerate: python3 tools/generate_font_subsets.py')
+    header.append('//')
+    header.append('// Only included by Fonts.cpp; use the pointers declared in Fonts.h')
+    header.append('// ============================================================================')
+    header.append('')
+    header.append('#include <U8g2lib.h>')
+    header.append('')
+    header.append('namespace fonts {')
+    header.append('namespace subsets {')
+
+    for name, font_name, charset in charsets:
+        header.append('')
+        if source is None:
+            header.append(f'    static const uint8_t* const {name} = {font_name};')
+            continue
+        font = read_font(source, font_name)
+        data, kept, total = subset_font(font, charset)
+        print(f'{font_name}: kept {kept} of {total} glyphs, {len(data)} of {len(font)} bytes')
+        header.append(f'    // {font_name}: {kept} of {total} glyphs, {len(data)} of {len(font)} bytes')
+        header.append(f'    static const uint8_t {name}[{len(data)}] = {{')
+        header.extend(format_bytes(data, '        '))
+        header.append('    };')
+
+    header.append('')
+    header.append('}  // namespace subsets')
+    header.append('}  // namespace fonts')
+    header.append('')
+    return '\n'.join(header)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('--libdeps', default=DEFAULT_LIBDEPS_DIR, help='PlatformIO libdeps directory')
+    args = parser.parse_args()
+
+    fonts_source = find_fonts_source(args.libdeps)
+    if fonts_source:
+        print(f'Reading fonts from: {fonts_source}')
+    else:
+        print('U8g2 sources not found, falling back to the full fonts')
+
+    ui_characters = scan_ui_characters()
+    print(f'Non-ASCII characters used in the UI: {ui_characters}')
+    charsets = []
+    for name, font_name, fixed, scan in SUBSETS:
+        charset = ''.join(sorted(set(fixed + (ui_characters if scan else ''))))
+        charsets.append((name, font_name, charset))
+
+    input_hash = get_input_hash(fonts_source, [(font_name, charset) for _, font_name, charset in charsets])
+    if parse_hash_from_existing(OUTPUT_FILE) == input_hash:
+        print('FontSubsets.h is up to date')
+        return
+
+    header_content = generate_header(fonts_source, charsets, input_hash)
+    print(f'Writing header file to: {OUTPUT_FILE}')
+    with open(OUTPUT_FILE, 'w', encoding='utf-8') as f:
+        f.write(header_content)
+
+    print('Done!')
+
+
+if __name__ == '__main__':
+    main()
@@ -1,7 +1,8 @@
 #!/usr/bin/env python3
 """
-Generate Timezones.h from posix_tz_db zones.json
-Creates a simple flat array of timezones with continent information
+Generate Timezones.h and Timezones.cpp from posix_tz_db zones.json
+Creates a simple flat array of timezones with continent information, its strings
+interned in a single pool
 """
 
 import json
@@ -15,6 +16,9 @@ SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
 SUBMODULE_DIR = os.path.join(SCRIPT_DIR, 'posix_tz_db')
 JSON_FILE = os.path.join(SUBMODULE_DIR, 'zones.json')
 OUTPUT_FILE = os.path.join(SCRIPT_DIR, '..', 'src', 'Timezones.h')
+SOURCE_OUTPUT_FILE = os.path.join(SCRIPT_DIR, '..', 'src', 'Timezones.cpp')
+# Stable IDs of the zones, as saved by the firmware. Kept in the repository, and only ever appended to
+IDS_FILE = os.path.join(SCRIPT_DIR, 'timezone_ids.json')
 
 def get_submodule_commit():
     """Get the current commit hash of the posix_tz_db submodule"""
@@ -67,6 +71,10 @@ def needs_regeneration():
     if existing_metadata is None:
         print("No existing file or metadata found, will generate")
         return True
+
+    if not os.path.exists(SOURCE_OUTPUT_FILE):
+        print("No existing catalogue found, will generate")
+        return True
     
     if existing_metadata.get('commit') != current_commit:
         print(f"Submodule commit changed: {existing_metadata.get('commit', 'unknown')} -> {current_commit}")
@@ -97,6 +105,7 @@ def parse_zones():
             city_display = city.replace('_', ' ')
             
             timezones.append({
+                'zone': zone_name,
                 'continent': continent,
                 'city': city_display,
                 'posix': posix_string
@@ -104,93 +113,227 @@ def parse_zones():
     
     return timezones
 
+def assign_ids(timezones):
+    """Give every zone its ID from timezone_ids.json, registering new zones with the next free IDs.
+    IDs are saved on the devices, so one is never changed nor reused, even once its zone is gone"""
+    ids = {}
+    if os.path.exists(IDS_FILE):
+        with open(IDS_FILE, 'r', encoding='utf-8') as f:
+            ids = json.load(f)
+    next_id = max(ids.values(), default=0) + 1
+    added = 0
+    for tz in timezones:
+        if tz['zone'] not in ids:
+            ids[tz['zone']] = next_id
+            next_id += 1
+            added += 1
+        tz['id'] = ids[tz['zone']]
+    if next_id > 0xFFFF:
+        raise ValueError('Timezone IDs no longer fit in 16 bits')
+    if added > 0 or not os.path.exists(IDS_FILE):
+        print(f'Registered {added} new timezone IDs in {IDS_FILE}, commit it')
+        with open(IDS_FILE, 'w', encoding='utf-8') as f:
+            json.dump(ids, f, indent=2, sort_keys=True)
+            f.write('\n')
+
 def escape_string(s):
     """Escape special characters in C strings"""
     return s.replace('\\', '\\\\').replace('"', '\\"')
 
+def build_string_pool(strings):
+    """Intern strings into one NUL-separated pool, returning it with the offset of each string.
+    Duplicates are stored once, and a string that ends another one reuses its tail"""
+    offsets = {}
+    pool = []
+    size = 0
+    # Longest first, so a string's tail can only be shared by those that come after it
+    for string in sorted(set(strings), key=lambda s: (-len(s.encode('utf-8')), s)):
+        for placed, offset in offsets.items():
+            if placed.endswith(string):
+                offsets[string] = offset + len(placed.encode('utf-8')) - len(string.encode('utf-8'))
+                break
+        else:
+            offsets[string] = size
+            pool.append(string)
+            size += len(string.encode('utf-8')) + 1
+    if size > 0xFFFF:
+        raise ValueError(f'String pool is {size} bytes, too large for 16-bit offsets')
+    return pool, offsets, size
+
+def metadata_banner(lines, commit_hash, json_hash, description):
+    """Append the banner common to the generated files"""
+    timestamp = datetime.now().strftime('%Y-%m-%d %H:%M:%S UTC')
+    lines.append('// ============================================================================')
+    lines.append('// AUTO-GENERATED FILE - DO NOT EDIT')
+    lines.append('// ============================================================================')
+    lines.append('//')
+    lines.append('// Generated from: posix_tz_db/zones.json')
+    lines.append(f'// Source: https://github.com/nayarsystems/posix_tz_db')
+    lines.append(f'// Submodule commit: {commit_hash}')
+    lines.append(f'// JSON hash: {json_hash}')
+    lines.append(f'// Generated at: {timestamp}')
+    for line in description:
+        lines.append(f'// {line}' if line else '//')
+    lines.append('//')
+    lines.append('// To regenerate: python3 tools/generate_timezones.py')
+    lines.append('// ============================================================================')
+    lines.append('')
+
+def default_timezone_index(timezones):
+    """Index of Europe/Paris, the default timezone"""
+    for idx, tz in enumerate(timezones):
+        if tz['continent'] == 'Europe' and tz['city'] == 'Paris':
+            return idx
+    return 0
+
+def letter_starts(timezones):
+    """TIMEZONES indices where a new initial letter starts within a continent, for jumping through
+    the menus letter by letter"""
+    starts = []
+    for idx, tz in enumerate(timezones):
+        if idx == 0 or tz['continent'] != timezones[idx - 1]['continent'] or tz['city'][0] != timezones[idx - 1]['city'][0]:
+            starts.append(idx)
+    return starts
+
 def generate_header(timezones, commit_hash, json_hash):
-    """Generate the Timezones.h header file with only static data"""
+    """Generate the Timezones.h header file, declaring the catalogue defined in Timezones.cpp"""
     
     # Count total timezones and continents
     total_timezones = len(timezones)
     continents = sorted(set(tz['continent'] for tz in timezones))
     
-    # Get generation timestamp
-    timestamp = datetime.now().strftime('%Y-%m-%d %H:%M:%S UTC')
-    
-    # Calculate max lengths for alignment
-    max_continent_len = max(len(tz['continent']) for tz in timezones)
-    max_city_len = max(len(escape_string(tz['city'])) for tz in timezones)
-    
     header = []
     header.append('#pragma once')
     header.append('')
-    header.append('// ============================================================================')
-    header.append('// AUTO-GENERATED FILE - DO NOT EDIT')
-    header.append('// ============================================================================')
-    header.append('//')
-    header.append('// Generated from: posix_tz_db/zones.json')
-    header.append(f'// Source: https://github.com/nayarsystems/posix_tz_db')
-    header.append(f'// Submodule commit: {commit_hash}')
-    header.append(f'// JSON hash: {json_hash}')
-    header.append(f'// Generated at: {timestamp}')
-    header.append(f'// Total timezones: {total_timezones}')
-    header.append(f'// Continents: {len(continents)}')
-    header.append('//')
-    header.append('// To regenerate: python3 tools/generate_timezones.py')
-    header.append('//')
-    header.append('// Note: Helper functions are in TimezoneHelpers.h')
-    header.append('// ============================================================================')
+    metadata_banner(header, commit_hash, json_hash, [
+        f'Total timezones: {total_timezones}',
+        f'Continents: {len(continents)}',
+        '',
+        'Note: The data is defined in Timezones.cpp, helper functions are in',
+        'TimezoneHelpers.h',
+    ])
+    header.append('#include <stdint.h>')
     header.append('')
     header.append('namespace timezones {')
-    header.append('    struct Timezone {')
-    header.append('        const char* continent;')
-    header.append('        const char* name;')
-    header.append('        const char* posixString;')
+    header.append('    // Every string of the catalogue, NUL-terminated and stored once; entries refer to')
+    header.append('    // them by 16-bit offset')
+    header.append('    extern const char STRING_POOL[];')
+    header.append('')
+    header.append('    // Timezones of a continent are TIMEZONES[begin, end), and the first timezone of each of their')
+    header.append('    // initial letters is listed in LETTER_INDEX[letterBegin, letterEnd)')
+    header.append('    struct Continent {')
+    header.append('        uint16_t nameOffset;')
+    header.append('        uint16_t begin;')
+    header.append('        uint16_t end;')
+    header.append('        uint16_t letterBegin;')
+    header.append('        uint16_t letterEnd;')
+    header.append('')
+    header.append('        const char* name() const { return STRING_POOL + nameOffset; }')
     header.append('    };')
     header.append('')
-    header.append('    // ========================================================================')
-    header.append('    // All Timezones (sorted alphabetically)')
-    header.append('    // ========================================================================')
+    header.append('    struct Timezone {')
+    header.append('        uint8_t continent;  // Index in CONTINENTS')
+    header.append('        uint16_t nameOffset;')
+    header.append('        uint16_t posixOffset;')
+    header.append('        uint16_t id;        // Stable across catalogue updates, what the firmware saves')
     header.append('')
-    header.append('    static const Timezone TIMEZONES[] = {')
-    
-    # Generate timezone entries
-    for tz in timezones:
-        continent = tz['continent']
-        city = escape_string(tz['city'])
-        posix = escape_string(tz['posix'])
-        
-        # Align the entries for better readability
-        continent_padding = ' ' * (max_continent_len - len(continent))
-        city_padding = ' ' * (max_city_len - len(city))
-        
-        header.append(f'        {{"{continent}",{continent_padding} "{city}",{city_padding} "{posix}"}},')
-    
+    header.append('        const char* name() const { return STRING_POOL + nameOffset; }')
+    header.append('        const char* posixString() const { return STRING_POOL + posixOffset; }')
     header.append('    };')
     header.append('')
-    header.append('    static const int TIMEZONE_COUNT = sizeof(TIMEZONES) / sizeof(Timezone);')
+    header.append(f'    static const int CONTINENT_COUNT = {len(continents)};')
+    header.append(f'    static const int TIMEZONE_COUNT = {total_timezones};')
+    header.append(f'    static const int LETTER_COUNT = {len(letter_starts(timezones))};')
     header.append('')
-    header.append('    // ========================================================================')
-    header.append('    // Default')
-    header.append('    // ========================================================================')
+    header.append('    // Default: Europe/Paris')
+    header.append(f'    static const int DEFAULT_TIMEZONE_INDEX = {default_timezone_index(timezones)};')
     header.append('')
-    
-    # Find default timezone (Europe/Paris)
-    default_index = 0
-    for idx, tz in enumerate(timezones):
-        if tz['continent'] == 'Europe' and tz['city'] == 'Paris':
-            default_index = idx
-            break
-    
-    header.append(f'    // Default: Europe/Paris')
-    header.append(f'    static const int DEFAULT_TIMEZONE_INDEX = {default_index};')
+    header.append('    // Continents, sorted alphabetically')
+    header.append('    extern const Continent CONTINENTS[CONTINENT_COUNT];')
+    header.append('    // All timezones, sorted alphabetically')
+    header.append('    extern const Timezone TIMEZONES[TIMEZONE_COUNT];')
+    header.append('    // TIMEZONES indices sorted by POSIX string (as strcmp orders them), then by index')
+    header.append('    extern const uint16_t POSIX_INDEX[TIMEZONE_COUNT];')
+    header.append('    // TIMEZONES indices sorted by ID')
+    header.append('    extern const uint16_t ID_INDEX[TIMEZONE_COUNT];')
+    header.append('    // TIMEZONES indices of the first timezone of each initial letter, continent by continent')
+    header.append('    extern const uint16_t LETTER_INDEX[LETTER_COUNT];')
     header.append('')
     header.append('}  // namespace timezones')
     header.append('')
     
     return '\n'.join(header)
 
+def generate_source(timezones, pool, offsets, pool_size, commit_hash, json_hash):
+    """Generate Timezones.cpp, the single definition of the catalogue"""
+    total_timezones = len(timezones)
+    continents = sorted(set(tz['continent'] for tz in timezones))
+    continent_ids = {continent: index for index, continent in enumerate(continents)}
+    total_strings = len(continents) + 2 * total_timezones
+
+    source = []
+    metadata_banner(source, commit_hash, json_hash, [
+        'Timezone catalogue declared in Timezones.h',
+    ])
+    source.append('#include "Timezones.h"')
+    source.append('')
+    source.append('namespace timezones {')
+    source.append(f'    // {pool_size} bytes, {len(offsets)} distinct strings out of {total_strings}')
+    source.append('    const char STRING_POOL[] =')
+    max_literal_len = max(len(escape_string(string)) for string in pool)
+    position = 0
+    for index, string in enumerate(pool):
+        literal = escape_string(string)
+        terminator = '' if index == len(pool) - 1 else '\\0'
+        padding = ' ' * (max_literal_len - len(literal) + (1 if not terminator else 0))
+        end = ';' if index == len(pool) - 1 else ''
+        source.append(f'        "{literal}{terminator}"{end}{padding}  // {position}')
+        position += len(string.encode('utf-8')) + 1
+    source.append('')
+    letters = letter_starts(timezones)
+    source.append('    const Continent CONTINENTS[CONTINENT_COUNT] = {')
+    begin = 0
+    letter_begin = 0
+    for continent in continents:
+        end = begin + sum(1 for tz in timezones if tz['continent'] == continent)
+        letter_end = letter_begin + sum(1 for start in letters if begin <= start < end)
+        source.append(f'        {{{offsets[continent]:>5}, {begin:>3}, {end:>3}, {letter_begin:>3}, {letter_end:>3}}},  // {continent}')
+        begin = end
+        letter_begin = letter_end
+    source.append('    };')
+    source.append('')
+    source.append('    const Timezone TIMEZONES[TIMEZONE_COUNT] = {')
+    previous_continent = None
+    for tz in timezones:
+        continent = tz['continent']
+        if continent != previous_continent:
+            source.append(f'        // {continent}')
+            previous_continent = continent
+        source.append(f'        {{{continent_ids[continent]:>2}, {offsets[tz["city"]]:>5}, {offsets[tz["posix"]]:>5}, {tz["id"]:>5}}},  // {tz["city"]}')
+    source.append('    };')
+    source.append('')
+    source.append('    const uint16_t POSIX_INDEX[TIMEZONE_COUNT] = {')
+    posix_order = sorted(range(total_timezones), key=lambda i: (timezones[i]['posix'].encode('utf-8'), i))
+    for start in range(0, total_timezones, 16):
+        source.append('        ' + ', '.join(str(i) for i in posix_order[start:start + 16]) + ',')
+    source.append('    };')
+    source.append('')
+    source.append('    const uint16_t ID_INDEX[TIMEZONE_COUNT] = {')
+    id_order = sorted(range(total_timezones), key=lambda i: timezones[i]['id'])
+    for start in range(0, total_timezones, 16):
+        source.append('        ' + ', '.join(str(i) for i in id_order[start:start + 16]) + ',')
+    source.append('    };')
+    source.append('')
+    source.append('    const uint16_t LETTER_INDEX[LETTER_COUNT] = {')
+    for start in range(0, len(letters), 16):
+        source.append('        ' + ', '.join(str(i) for i in letters[start:start + 16]) + ',')
+    source.append('    };')
+    source.append('')
+    source.append('}  // namespace timezones')
+    source.append('')
+
+    return '\n'.join(source)
+
 def main():
     print(f'Reading timezone data from: {JSON_FILE}')
     
@@ -200,6 +343,7 @@ def main():
         return
     
     timezones = parse_zones()
+    assign_ids(timezones)
     
     print(f'Found {len(timezones)} timezones')
     continents = sorted(set(tz['continent'] for tz in timezones))
@@ -213,6 +357,14 @@ def main():
     print(f'Writing header file to: {OUTPUT_FILE}')
     with open(OUTPUT_FILE, 'w', encoding='utf-8') as f:
         f.write(header_content)
+
+    strings = continents + [tz['city'] for tz in timezones] + [tz['posix'] for tz in timezones]
+    pool, offsets, pool_size = build_string_pool(strings)
+    print(f'String pool: {pool_size} bytes, {len(offsets)} distinct strings out of {len(strings)}')
+
+    print(f'Writing catalogue to: {SOURCE_OUTPUT_FILE}')
+    with open(SOURCE_OUTPUT_FILE, 'w', encoding='utf-8') as f:
+        f.write(generate_source(timezones, pool, offsets, pool_size, commit_hash, json_hash))
     
     print('Done!')
 
@@ -0,0 +1,18 @@
+#pragma once
+
+// Minimal stand-in for the Arduino core, enough to build the views and the display code on a host
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <algorithm>
+#include <cmath>
+
+using std::abs;
+using std::isnan;
+using std::max;
+using std::min;
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
@@ -0,0 +1,257 @@
+#include "HostDisplay.h"
+#include "Fonts.h"
+
+namespace {
+    // U8g2 callbacks carry no context, and tests only ever drive one display at a time
+    uint32_t* transferredBytes = nullptr;
+}
+
+HostDisplay::HostDisplay() :
+    _framePending(false),
+    _font(nullptr),
+    _drawColor(1),
+    _cursorX(0),
+    _cursorY(0),
+    _primitives(0),
+    _bytesSent(0),
+    _lastFrame{0, 0, 0}
+{
+    u8g2_Setup_sh1106_i2c_128x64_noname_f(&_u8g2, U8G2_R0, &HostDisplay::countBytes, &HostDisplay::ignoreGpio);
+    _dirty.markAll();
+}
+
+void HostDisplay::begin() {
+    transferredBytes = &_bytesSent;
+    u8g2_InitDisplay(&_u8g2);
+    u8g2_SetPowerSave(&_u8g2, 0);
+    _glyphCache.add(&_u8g2, fonts::REGULAR);
+    _glyphCache.add(&_u8g2, fonts::LARGE);
+    u8g2_ClearBuffer(&_u8g2);
+    if (_font) u8g2_SetFont(&_u8g2, _font);
+    u8g2_SetFontMode(&_u8g2, 0);
+    u8g2_SetDrawColor(&_u8g2, _drawColor);
+    // The initialisation sequence is not part of any frame
+    _bytesSent = 0;
+    _dirty.markAll();
+}
+
+void HostDisplay::update() {
+    if (_framePending) {
+        flush();
+    }
+}
+
+void HostDisplay::clear() {
+    clearBuffer();
+}
+
+void HostDisplay::clearBuffer() {
+    u8g2_ClearBuffer(&_u8g2);
+    _dirty.markAll();
+    onBufferCleared();
+}
+
+void HostDisplay::sendBuffer() {
+    _framePending = true;
+}
+
+void HostDisplay::flush() {
+    _framePending = false;
+    transferredBytes = &_bytesSent;
+    uint8_t* buffer = u8g2_GetBufferPtr(&_u8g2);
+    FrameStats stats = {_primitives, 0, 0};
+    for (uint8_t row = 0; row < DirtyTiles::ROWS; row++) {
+        if (!_dirty.isRowDirty(row)) {
+            continue;
+        }
+        const uint8_t firstColumn = _dirty.firstColumn(row);
+        const uint8_t columnCount = _dirty.columnCount(row);
+        u8x8_DrawTile(u8g2_GetU8x8(&_u8g2), firstColumn, row, columnCount, buffer + row * ROW_BYTES + firstColumn * DirtyTiles::TILE_SIZE);
+        stats.tiles += columnCount;
+    }
+    stats.bytes = _bytesSent;
+    _dirty.clear();
+    _bytesSent = 0;
+    _primitives = 0;
+    _lastFrame = stats;
+}
+
+void HostDisplay::drawStr(uint8_t x, uint8_t y, const char* str) {
+    drawUTF8(x, y, str);
+}
+
+void HostDisplay::drawUTF8(uint8_t x, uint8_t y, const char* str) {
+    _primitives++;
+    markTextDirty(x, y, u8g2_DrawUTF8(&_u8g2, x, y, str));
+}
+
+void HostDisplay::drawNumeric(uint8_t x, uint8_t y, const char* str) {
+    if (_drawColor != 1 || !_glyphCache.contains(_font, str)) {
+        drawUTF8(x, y, str);
+        return;
+    }
+    _primitives++;
+    markTextDirty(x, y, _glyphCache.draw(u8g2_GetBufferPtr(&_u8g2), _font, x, y, str));
+}
+
+uint8_t HostDisplay::getNumericWidth(const char* str) {
+    if (!_glyphCache.contains(_font, str)) {
+        return getUTF8Width(str);
+    }
+    return _glyphCache.getWidth(_font, str);
+}
+
+void HostDisplay::drawBox(uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
+    _primitives++;
+    u8g2_DrawBox(&_u8g2, x, y, w, h);
+    _dirty.mark(x, y, w, h);
+}
+
+void HostDisplay::drawRBox(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t r) {
+    _primitives++;
+    u8g2_DrawRBox(&_u8g2, x, y, w, h, r);
+    _dirty.mark(x, y, w, h);
+}
+
+void HostDisplay::drawFrame(int16_t x, int16_t y, uint8_t w, uint8_t h) {
+    _primitives++;
+    u8g2_DrawFrame(&_u8g2, x, y, w, h);
+    _dirty.mark(x, y, w, h);
+}
+
+void HostDisplay::drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    _primitives++;
+    u8g2_DrawLine(&_u8g2, x0, y0, x1, y1);
+    _dirty.mark(min(x0, x1), min(y0, y1), abs(x1 - x0) + 1, abs(y1 - y0) + 1);
+}
+
+void HostDisplay::drawPixel(int16_t x, int16_t y) {
+    _primitives++;
+    u8g2_DrawPixel(&_u8g2, x, y);
+    _dirty.mark(x, y, 1, 1);
+}
+
+void HostDisplay::drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2) {
+    _primitives++;
+    u8g2_DrawTriangle(&_u8g2, x0, y0, x1, y1, x2, y2);
+    const int16_t minX = min(x0, min(x1, x2));
+    const int16_t minY = min(y0, min(y1, y2));
+    _dirty.mark(minX, minY, max(x0, max(x1, x2)) - minX + 1, max(y0, max(y1, y2)) - minY + 1);
+}
+
+void HostDisplay::drawHLine(uint8_t x, uint8_t y, uint8_t w) {
+    _primitives++;
+    u8g2_DrawHLine(&_u8g2, x, y, w);
+    _dirty.mark(x, y, w, 1);
+}
+
+void HostDisplay::drawVLine(uint8_t x, uint8_t y, uint8_t h) {
+    _primitives++;
+    u8g2_DrawVLine(&_u8g2, x, y, h);
+    _dirty.mark(x, y, 1, h);
+}
+
+void HostDisplay::drawXBMP(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t* bitmap) {
+    _primitives++;
+    u8g2_DrawXBMP(&_u8g2, x, y, w, h, bitmap);
+    _dirty.mark(x, y, w, h);
+}
+
+void HostDisplay::setDrawColor(uint8_t color) {
+    _drawColor = color;
+    u8g2_SetDrawColor(&_u8g2, color);
+}
+
+void HostDisplay::setFont(const uint8_t* font) {
+    _font = font;
+    u8g2_SetFont(&_u8g2, font);
+}
+
+void HostDisplay::setFontMode(uint8_t mode) {
+    u8g2_SetFontMode(&_u8g2, mode);
+}
+
+void HostDisplay::setBitmapMode(uint8_t mode) {
+    u8g2_SetBitmapMode(&_u8g2, mode);
+}
+
+uint8_t HostDisplay::getStrWidth(const char* str) {
+    return u8g2_GetStrWidth(&_u8g2, str);
+}
+
+uint8_t HostDisplay::getUTF8Width(const char* str) {
+    return u8g2_GetUTF8Width(&_u8g2, str);
+}
+
+uint8_t HostDisplay::getAscent() {
+    return u8g2_GetAscent(&_u8g2);
+}
+
+uint8_t HostDisplay::getDescent() {
+    return u8g2_GetDescent(&_u8g2);
+}
+
+uint8_t HostDisplay::getDisplayWidth() {
+    return u8g2_GetDisplayWidth(&_u8g2);
+}
+
+uint8_t HostDisplay::getDisplayHeight() {
+    return u8g2_GetDisplayHeight(&_u8g2);
+}
+
+uint8_t HostDisplay::getWidth() {
+    return u8g2_GetDisplayWidth(&_u8g2);
+}
+
+void HostDisplay::setCursor(const uint8_t x, const uint8_t y) {
+    _cursorX = x;
+    _cursorY = y;
+}
+
+void HostDisplay::print(const char* str) {
+    const uint8_t startX = _cursorX;
+    _primitives++;
+    _cursorX += u8g2_DrawUTF8(&_u8g2, _cursorX, _cursorY, str);
+    markTextDirty(startX, _cursorY, _cursorX - startX);
+}
+
+bool HostDisplay::writePbm(const char* path) {
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    const uint8_t width = getDisplayWidth();
+    const uint8_t height = getDisplayHeight();
+    const uint8_t* buffer = u8g2_GetBufferPtr(&_u8g2);
+    fprintf(file, "P4\n%d %d\n", width, height);
+    // PBM rows are packed 8 pixels per byte, leftmost pixel in the most significant bit
+    for (uint8_t y = 0; y < height; y++) {
+        for (uint8_t x = 0; x < width; x += 8) {
+            uint8_t packed = 0;
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                if (buffer[(y / 8) * ROW_BYTES + x + bit] & (1 << (y % 8))) {
+                    packed |= 0x80 >> bit;
+                }
+            }
+            fputc(packed, file);
+        }
+    }
+    return fclose(file) == 0;
+}
+
+void HostDisplay::markTextDirty(int16_t x, int16_t y, int16_t w) {
+    // The tallest glyph can rise above the reference ascent (e.g. accented capitals)
+    const int16_t top = y - u8g2_GetMaxCharHeight(&_u8g2);
+    _dirty.mark(x, top, w, y - u8g2_GetDescent(&_u8g2) - top);
+}
+
+uint8_t HostDisplay::countBytes(u8x8_t* u8x8, uint8_t msg, uint8_t argInt, void* argPtr) {
+    if (msg == U8X8_MSG_BYTE_SEND && transferredBytes) {
+        *transferredBytes += argInt;
+    }
+    return 1;
+}
+
+uint8_t HostDisplay::ignoreGpio(u8x8_t* u8x8, uint8_t msg, uint8_t argInt, void* argPtr) {
+    return 1;
+}
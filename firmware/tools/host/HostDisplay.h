@@ -0,0 +1,78 @@
+#pragma once
+
+#include <U8g2lib.h>
+#include "DisplayBase.h"
+#include "DirtyTiles.h"
+#include "GlyphCache.h"
+
+// Display backend for host tests, selected with DISPLAY_BACKEND_HOST. It renders with the U8g2
+// C library into the same SH1106 frame buffer as the firmware, flushes dirty tiles the same way,
+// and counts the draw calls and I2C bytes each frame costs instead of sending them anywhere.
+class HostDisplay final : public DisplayBase<HostDisplay> {
+public:
+    struct FrameStats {
+        uint32_t primitives; // Draw calls made for the frame
+        uint32_t tiles;      // 8x8 tiles transferred
+        uint32_t bytes;      // Bytes sent over I2C, commands included
+    };
+
+    HostDisplay();
+    void begin();
+    void update();
+    bool isFrameDue() const { return true; }
+    void clear();
+    void drawStr(uint8_t x, uint8_t y, const char* str);
+    void drawBox(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+    void drawRBox(uint8_t x, uint8_t y, uint8_t w, uint8_t h, uint8_t r);
+    void drawFrame(int16_t x, int16_t y, uint8_t w, uint8_t h);
+    void drawPixel(int16_t x, int16_t y);
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+    void setDrawColor(uint8_t color);
+    uint8_t getStrWidth(const char* str);
+    uint8_t getUTF8Width(const char* str);
+    uint8_t getAscent();
+    uint8_t getDescent();
+    uint8_t getDisplayWidth();
+    uint8_t getDisplayHeight();
+    uint8_t getWidth();
+    void drawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2);
+    void sendBuffer();
+    void flush();
+    void clearBuffer();
+    void setFont(const uint8_t* font);
+    void drawUTF8(uint8_t x, uint8_t y, const char* str);
+    void drawNumeric(uint8_t x, uint8_t y, const char* str);
+    uint8_t getNumericWidth(const char* str);
+    void drawHLine(uint8_t x, uint8_t y, uint8_t w);
+    void drawVLine(uint8_t x, uint8_t y, uint8_t h);
+    void setFontMode(uint8_t mode);
+    void setBitmapMode(uint8_t mode);
+    void drawXBMP(int16_t x, int16_t y, uint8_t w, uint8_t h, const uint8_t* bitmap);
+
+    void setCursor(const uint8_t x, const uint8_t y);
+    void print(const char* str);
+
+    // Cost of the last frame committed by flush()
+    const FrameStats& getLastFrameStats() const { return _lastFrame; }
+    // Write the frame buffer as a binary PBM image, lit pixels being black
+    bool writePbm(const char* path);
+
+private:
+    static constexpr uint16_t ROW_BYTES = DirtyTiles::COLUMNS * DirtyTiles::TILE_SIZE;
+
+    u8g2_t _u8g2;
+    DirtyTiles _dirty;
+    bool _framePending;
+    const uint8_t* _font;
+    uint8_t _drawColor;
+    GlyphCache _glyphCache;
+    uint8_t _cursorX;
+    uint8_t _cursorY;
+    uint32_t _primitives;
+    uint32_t _bytesSent;
+    FrameStats _lastFrame;
+
+    void markTextDirty(int16_t x, int16_t y, int16_t w);
+    static uint8_t countBytes(u8x8_t* u8x8, uint8_t msg, uint8_t argInt, void* argPtr);
+    static uint8_t ignoreGpio(u8x8_t* u8x8, uint8_t msg, uint8_t argInt, void* argPtr);
+};
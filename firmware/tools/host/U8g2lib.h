@@ -0,0 +1,4 @@
+#pragma once
+
+// The host build uses the U8g2 C library directly; the Arduino C++ wrapper needs the Arduino core
+#include <clib/u8g2.h>
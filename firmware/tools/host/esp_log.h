@@ -0,0 +1,7 @@
+#pragma once
+
+// Logging is dropped on the host
+#define ESP_LOGE(tag, format, ...) ((void)0)
+#define ESP_LOGW(tag, format, ...) ((void)0)
+#define ESP_LOGI(tag, format, ...) ((void)0)
+#define ESP_LOGD(tag, format, ...) ((void)0)
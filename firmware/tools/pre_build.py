@@ -1,5 +1,5 @@
 """
-PlatformIO pre-build script to generate Timezones.h
+PlatformIO pre-build script to generate Timezones.h and FontSubsets.h
 """
 
 Import("env")
@@ -9,31 +9,38 @@ import os
 
 # Get the project directory
 project_dir = env['PROJECT_DIR']
-script_path = os.path.join(project_dir, 'tools', 'generate_timezones.py')
+libdeps_dir = env.subst('$PROJECT_LIBDEPS_DIR')
 
-print("=" * 60)
-print("Running timezone generator...")
-print("=" * 60)
+def run_generator(description, script_name, args=()):
+    script_path = os.path.join(project_dir, 'tools', script_name)
 
-try:
-    result = subprocess.run(
-        [sys.executable, script_path],
-        cwd=project_dir,
-        capture_output=True,
-        text=True,
-        check=True
-    )
-    print(result.stdout)
-    if result.stderr:
-        print(result.stderr, file=sys.stderr)
-    print("Timezone generation completed successfully")
-except subprocess.CalledProcessError as e:
-    print(f"ERROR: Failed to generate timezones: {e}", file=sys.stderr)
-    print(f"stdout: {e.stdout}", file=sys.stderr)
-    print(f"stderr: {e.stderr}", file=sys.stderr)
-    sys.exit(1)
-except Exception as e:
-    print(f"ERROR: Unexpected error: {e}", file=sys.stderr)
-    sys.exit(1)
+    print("=" * 60)
+    print(f"Running {description} generator...")
+    print("=" * 60)
 
-print("=" * 60)
+    try:
+        result = subprocess.run(
+            [sys.executable, script_path, *args],
+            cwd=project_dir,
+            capture_output=True,
+            text=True,
+            check=True
+        )
+        print(result.stdout)
+        if result.stderr:
+            print(result.stderr, file=sys.stderr)
+        print(f"{description.capitalize()} generation completed successfully")
+    except subprocess.CalledProcessError as e:
+        print(f"ERROR: Failed to generate {description}: {e}", file=sys.stderr)
+        print(f"stdout: {e.stdout}", file=sys.stderr)
+        print(f"stderr: {e.stderr}", file=sys.stderr)
+        sys.exit(1)
+    except Exception as e:
+        print(f"ERROR: Unexpected error: {e}", file=sys.stderr)
+        sys.exit(1)
+
+    print("=" * 60)
+
+run_generator('timezone', 'generate_timezones.py')
+# Runs after the timezone generator, since timezone names are part of the scanned UI strings
+run_generator('font subset', 'generate_font_subsets.py', ['--libdeps', libdeps_dir])
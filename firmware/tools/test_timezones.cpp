@@ -1,9 +1,93 @@
 // Simple test to verify Timezones.h structure
+// Build from firmware/: g++ -std=gnu++17 -O2 -o test_timezones tools/test_timezones.cpp src/Timezones.cpp
 #include "../src/Timezones.h"
 #include "../src/TimezoneHelpers.h"
 #include <iostream>
+#include <chrono>
 #include <cstring>
 
+// The helpers as they were before the catalogue was indexed: linear scans of TIMEZONES. They
+// check the indexed helpers' results and give them a baseline to be timed against.
+namespace linear {
+    int getTimezoneCount(const char* continent) {
+        int count = 0;
+        for (int i = 0; i < timezones::TIMEZONE_COUNT; i++) {
+            if (strcmp(timezones::CONTINENTS[timezones::TIMEZONES[i].continent].name(), continent) == 0) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    const timezones::Timezone* getTimezone(const char* continent, int localIndex) {
+        int currentIndex = -1;
+        for (int i = 0; i < timezones::TIMEZONE_COUNT; i++) {
+            if (strcmp(timezones::CONTINENTS[timezones::TIMEZONES[i].continent].name(), continent) == 0) {
+                currentIndex++;
+                if (currentIndex == localIndex) {
+                    return &timezones::TIMEZONES[i];
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    int findTimezoneIndex(const char* posixString) {
+        for (int i = 0; i < timezones::TIMEZONE_COUNT; i++) {
+            if (strcmp(timezones::TIMEZONES[i].posixString(), posixString) == 0) {
+                return i;
+            }
+        }
+        return timezones::DEFAULT_TIMEZONE_INDEX;
+    }
+
+    // Whether two names start with the same character, which may take several UTF-8 bytes
+    bool sameInitial(const char* a, const char* b) {
+        int length = 1;
+        while ((a[length] & 0xC0) == 0x80) {
+            length++;
+        }
+        return strncmp(a, b, length) == 0 && (b[length] & 0xC0) != 0x80;
+    }
+
+    int getNextLetterIndex(int timezoneIndex) {
+        const timezones::Continent& continent = timezones::CONTINENTS[timezones::TIMEZONES[timezoneIndex].continent];
+        int next = timezoneIndex + 1;
+        while (next < continent.end && sameInitial(timezones::TIMEZONES[next].name(), timezones::TIMEZONES[timezoneIndex].name())) {
+            next++;
+        }
+        return next - continent.begin;
+    }
+
+    int getPreviousLetterIndex(int timezoneIndex) {
+        const timezones::Continent& continent = timezones::CONTINENTS[timezones::TIMEZONES[timezoneIndex].continent];
+        if (timezoneIndex == continent.begin) {
+            return -1;
+        }
+        // Start of the letter of the timezone just before
+        int previous = timezoneIndex - 1;
+        while (previous > continent.begin && sameInitial(timezones::TIMEZONES[previous - 1].name(), timezones::TIMEZONES[previous].name())) {
+            previous--;
+        }
+        return previous - continent.begin;
+    }
+}
+
+// Average time of one lookup, in nanoseconds, over every timezone repeated a few times
+template <typename Lookup>
+static double timeLookups(Lookup lookup) {
+    static constexpr int ROUNDS = 200;
+    volatile long sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 0; i < timezones::TIMEZONE_COUNT; i++) {
+            sink = sink + lookup(i);
+        }
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (ROUNDS * timezones::TIMEZONE_COUNT);
+}
+
 int main() {
     std::cout << "Testing generated Timezones.h..." << std::endl;
     
@@ -38,9 +122,9 @@ int main() {
     // Look for Paris
     for (int i = 0; i < europeCount; i++) {
         const timezones::Timezone* tz = timezones::getTimezone("Europe", i);
-        if (tz && strcmp(tz->name, "Paris") == 0) {
+        if (tz && strcmp(tz->name(), "Paris") == 0) {
             foundParis = true;
-            std::cout << "    Found Paris: " << tz->posixString << std::endl;
+            std::cout << "    Found Paris: " << tz->posixString() << std::endl;
             break;
         }
     }
@@ -52,9 +136,10 @@ int main() {
     
     // Test default timezone
     const timezones::Timezone& defaultTz = timezones::TIMEZONES[timezones::DEFAULT_TIMEZONE_INDEX];
-    std::cout << "Default timezone: " << defaultTz.continent << "/" << defaultTz.name << std::endl;
+    const char* defaultContinent = timezones::getContinentName(defaultTz.continent);
+    std::cout << "Default timezone: " << defaultContinent << "/" << defaultTz.name() << std::endl;
     
-    if (strcmp(defaultTz.continent, "Europe") != 0 || strcmp(defaultTz.name, "Paris") != 0) {
+    if (strcmp(defaultContinent, "Europe") != 0 || strcmp(defaultTz.name(), "Paris") != 0) {
         std::cerr << "ERROR: Default timezone is not Europe/Paris!" << std::endl;
         return 1;
     }
@@ -66,6 +151,54 @@ int main() {
         return 1;
     }
     std::cout << "findTimezoneIndex test passed (Paris at index " << parisIndex << ")" << std::endl;
+
+    // The indexed helpers must agree with the linear scans for every timezone
+    for (int i = 0; i < timezones::TIMEZONE_COUNT; i++) {
+        const timezones::Timezone& tz = timezones::TIMEZONES[i];
+        const char* continentName = timezones::getContinentName(tz.continent);
+        const int localIndex = timezones::getLocalTimezoneIndex(i);
+        if (timezones::findContinentIndex(continentName) != tz.continent
+            || timezones::getTimezoneCount(continentName) != linear::getTimezoneCount(continentName)
+            || timezones::getTimezone(tz.continent, localIndex) != &tz
+            || timezones::getTimezone(continentName, localIndex) != linear::getTimezone(continentName, localIndex)
+            || timezones::findTimezoneIndex(tz.posixString()) != linear::findTimezoneIndex(tz.posixString())
+            || timezones::findTimezoneIndexById(tz.id) != i
+            || timezones::getNextLetterIndex(tz.continent, localIndex) != linear::getNextLetterIndex(i)
+            || timezones::getPreviousLetterIndex(tz.continent, localIndex) != linear::getPreviousLetterIndex(i)) {
+            std::cerr << "ERROR: indexed lookup mismatch for " << continentName << "/" << tz.name() << std::endl;
+            return 1;
+        }
+    }
+    if (timezones::findContinentIndex("Atlantis") != -1
+        || timezones::findTimezoneIndex("XYZ0") != timezones::DEFAULT_TIMEZONE_INDEX
+        || timezones::findTimezoneIndexById(0) != timezones::DEFAULT_TIMEZONE_INDEX) {
+        std::cerr << "ERROR: lookup of a missing entry did not fail" << std::endl;
+        return 1;
+    }
+    std::cout << "Indexed lookups match linear scans" << std::endl;
+
+    // Micro-benchmark, each lookup done for every timezone
+    const double linearFind = timeLookups([](int i) {
+        return linear::findTimezoneIndex(timezones::TIMEZONES[i].posixString());
+    });
+    const double indexedFind = timeLookups([](int i) {
+        return timezones::findTimezoneIndex(timezones::TIMEZONES[i].posixString());
+    });
+    const double linearGet = timeLookups([](int i) {
+        const timezones::Timezone& tz = timezones::TIMEZONES[i];
+        return (long)linear::getTimezone(timezones::CONTINENTS[tz.continent].name(), timezones::getLocalTimezoneIndex(i))->continent;
+    });
+    const double indexedGet = timeLookups([](int i) {
+        const timezones::Timezone& tz = timezones::TIMEZONES[i];
+        return (long)timezones::getTimezone(tz.continent, timezones::getLocalTimezoneIndex(i))->continent;
+    });
+    std::cout << "findTimezoneIndex: " << indexedFind << " ns (linear scan: " << linearFind << " ns)" << std::endl;
+    std::cout << "getTimezone: " << indexedGet << " ns (linear scan: " << linearGet << " ns)" << std::endl;
+    // Small catalogues are too quick to time reliably; the full one has hundreds of entries
+    if (timezones::TIMEZONE_COUNT >= 100 && (indexedFind > linearFind || indexedGet > linearGet)) {
+        std::cerr << "ERROR: indexed lookups are slower than linear scans" << std::endl;
+        return 1;
+    }
     
     std::cout << "All tests passed!" << std::endl;
     return 0;
@@ -0,0 +1,237 @@
+// Golden-image test for the views, rendered with the host display backend
+//
+// Build (after a firmware build, which installs U8g2 and generates FontSubsets.h), from firmware/,
+// with the g++ command on a single line:
+//   U8G2=.pio/libdeps/esp32/U8g2/src
+//   mkdir -p .pio/host && (cd .pio/host && gcc -O2 -c ../../$U8G2/clib/*.c)
+//   g++ -std=gnu++17 -DDISPLAY_BACKEND_HOST -Itools/host -Isrc -I$U8G2 -o .pio/host/test_views
+//       tools/test_views.cpp tools/host/HostDisplay.cpp src/Graph.cpp src/GlyphCache.cpp
+//       src/Fonts.cpp src/screens/views/*.cpp .pio/host/*.o
+//   .pio/host/test_views [--update]
+//
+// Each screen is compared against tools/golden/<name>.pbm, and a missing golden is a failure:
+// --update records all of them, after an intended rendering change or for a new screen. The draw
+// calls and I2C bytes of every frame are printed so their cost can be tracked.
+#include "../src/DisplayBackend.h"
+#include "../src/Graph.h"
+#include "../src/screens/views/AdjustTimeView.h"
+#include "../src/screens/views/AdjustValueView.h"
+#include "../src/screens/views/ChartView.h"
+#include "../src/screens/views/ConfirmTimezoneView.h"
+#include "../src/screens/views/CoolingView.h"
+#include "../src/screens/views/DataDisplayView.h"
+#include "../src/screens/views/MenuView.h"
+#include "../src/screens/views/PowerOffView.h"
+#include "../src/screens/views/ProofingView.h"
+#include "../src/screens/views/RebootView.h"
+#include "../src/screens/views/WiFiResetView.h"
+#include "../src/icons.h"
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <cstdio>
+#include <cstring>
+
+static const std::string GOLDEN_DIR = "tools/golden/";
+
+static HostDisplay display;
+static bool updateGoldens = false;
+static int failures = 0;
+
+static std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Commit the frame the way loop() does, unless the view already did, then compare it with its
+// golden image
+static void checkFrame(const char* name, bool commit = true) {
+    if (commit) {
+        display.sendBuffer();
+        display.update();
+    }
+    const HostDisplay::FrameStats& stats = display.getLastFrameStats();
+
+    const std::string goldenPath = GOLDEN_DIR + name + ".pbm";
+    const std::string actualPath = GOLDEN_DIR + name + ".actual.pbm";
+    if (!display.writePbm((updateGoldens ? goldenPath : actualPath).c_str())) {
+        std::cerr << "ERROR: cannot write " << (updateGoldens ? goldenPath : actualPath) << std::endl;
+        failures++;
+        return;
+    }
+
+    std::cout << "  " << name << ": " << stats.primitives << " draw calls, "
+              << stats.tiles << " tiles, " << stats.bytes << " I2C bytes";
+    if (updateGoldens) {
+        std::cout << " (recorded)" << std::endl;
+    } else if (readFile(goldenPath).empty()) {
+        std::cout << " NO GOLDEN, see " << actualPath << " and record it with --update" << std::endl;
+        failures++;
+    } else if (readFile(actualPath) != readFile(goldenPath)) {
+        std::cout << " MISMATCH, see " << actualPath << std::endl;
+        failures++;
+    } else {
+        std::cout << std::endl;
+        std::remove(actualPath.c_str());
+    }
+}
+
+// Menu contents, as in MenuItems.cpp; every item leads to a submenu, since Menu and its actions
+// are not part of the test
+constexpr BackMenuList emptyMenu;
+constexpr MenuItem testMenuItems[] = {
+    {"Pousse imm\xC3\xA9" "diate",       iconProof,    &emptyMenu, nullptr},
+    {"Pousse diff\xC3\xA9r\xC3\xA9" "e", iconCool,     &emptyMenu, nullptr},
+    {"R\xC3\xA9glages",                  iconSettings, &emptyMenu, nullptr},
+    {"\xC3\x89teindre",                  iconReset,    &emptyMenu, nullptr},
+};
+constexpr MenuItem testLongMenuItems[] = {
+    {"Abidjan",     nullptr,   &emptyMenu, nullptr},
+    {"Accra",       nullptr,   &emptyMenu, nullptr},
+    {"Addis Ababa", nullptr,   &emptyMenu, nullptr},
+    {"Algiers",     nullptr,   &emptyMenu, nullptr},
+    {"Bamako",      iconCheck, &emptyMenu, nullptr},
+    {"Bangui",      nullptr,   &emptyMenu, nullptr},
+    {"Banjul",      nullptr,   &emptyMenu, nullptr},
+    {"Bissau",      nullptr,   &emptyMenu, nullptr},
+    {"Retour",      iconBack,  &emptyMenu, nullptr},
+};
+constexpr StaticMenuList testMenu(testMenuItems);
+constexpr StaticMenuList testLongMenu(testLongMenuItems);
+
+static void fillGraph(Graph& graph, float start, float step, uint8_t relay) {
+    graph.configure(30, 15, true);
+    for (int i = 0; i < 24; i++) {
+        graph.addPoint(start + step * i, (i / 4) % 2 == 0 ? relay : 0);
+    }
+}
+
+int main(int argc, char** argv) {
+    updateGoldens = argc > 1 && strcmp(argv[1], "--update") == 0;
+    // Titles that show times must not depend on the machine running the test
+    setenv("TZ", "UTC0", 1);
+    tzset();
+
+    std::cout << "Rendering views..." << std::endl;
+    display.begin();
+
+    Graph graph;
+
+    ProofingView proofingView(&display);
+    fillGraph(graph, 22.0, 0.25, Graph::HEATER);
+    proofingView.start(24.5, graph);
+    proofingView.drawIcons(OptionalBool(true));
+    checkFrame("proofing_start");
+    proofingView.drawTime(3 * 3600 + 25 * 60);
+    proofingView.drawTemperature(26.8);
+    checkFrame("proofing_update");
+    proofingView.drawSelection(true, graph);
+    checkFrame("proofing_graph_selected");
+
+    CoolingView coolingView(&display);
+    fillGraph(graph, 8.0, -0.2, Graph::COOLER);
+    coolingView.start(7 * 3600 + 30 * 60, CoolingView::Selection::Start, graph);
+    coolingView.drawTime(5 * 3600 + 12 * 60);
+    coolingView.drawTemperature(4.2);
+    coolingView.drawIcons(OptionalBool(true));
+    checkFrame("cooling_start");
+    coolingView.drawSelection(CoolingView::Selection::Cancel, graph);
+    checkFrame("cooling_cancel_selected");
+    coolingView.drawSelection(CoolingView::Selection::Graph, graph);
+    checkFrame("cooling_graph_selected");
+
+    ChartView chartView(&display);
+    graph.configure(30, 15, true);
+    for (int i = 0; i < MAX_GRAPH_WIDTH; i++) {
+        // Heater cycling around 26°C
+        const bool heating = (i / 6) % 2 == 0;
+        graph.addPoint(26.0 + (heating ? 0.1 * (i % 6) : 0.6 - 0.1 * (i % 6)), heating ? Graph::HEATER : 0);
+    }
+    chartView.reset();
+    chartView.draw(graph, 0, 1, 0, 10, false);
+    checkFrame("chart");
+    chartView.draw(graph, 0, 4, 20, 10, true);
+    checkFrame("chart_zoomed_panned");
+    // A 12 hour retard, one point every 10s, slowly cooling down then holding
+    graph.clear();
+    for (int i = 0; i < 12 * 360; i++) {
+        const bool cooling = (i / 30) % 2 == 0;
+        graph.addPoint(max(4.0, 20.0 - i / 60.0) + (cooling ? 0.3 : -0.3), cooling ? Graph::COOLER : 0);
+    }
+    const uint8_t sessionLevel = graph.getLevelFor(103);
+    chartView.reset();
+    chartView.draw(graph, sessionLevel, 1, 0, 10 * Graph::getLevelScale(sessionLevel), false);
+    checkFrame("chart_session");
+
+    DataDisplayView dataDisplayView(&display);
+    dataDisplayView.start();
+    tm now = {};
+    now.tm_year = 125;
+    now.tm_mon = 2;
+    now.tm_mday = 14;
+    now.tm_hour = 9;
+    now.tm_min = 41;
+    dataDisplayView.drawTime(now);
+    dataDisplayView.drawTemperature(21.3);
+    dataDisplayView.drawTimeZone("Europe/Paris");
+    checkFrame("data_display");
+
+    AdjustValueView adjustValueView(&display);
+    const uint8_t valueY = adjustValueView.start("Temp\xC3\xA9rature de\npousse", 25);
+    checkFrame("adjust_value");
+    adjustValueView.drawValue(-3, valueY);
+    checkFrame("adjust_value_negative");
+
+    AdjustTimeView adjustTimeView(&display);
+    const uint8_t timeY = adjustTimeView.start("D\xC3\xA9marrage dans", SimpleTime(1, 7, 30), 0);
+    checkFrame("adjust_time");
+    adjustTimeView.drawHighlight(1, timeY);
+    checkFrame("adjust_time_minutes");
+    adjustTimeView.drawButtons(0);
+    checkFrame("adjust_time_start_selected");
+
+    ConfirmTimezoneView confirmTimezoneView(&display);
+    confirmTimezoneView.setTimezone("Europe", "Paris");
+    confirmTimezoneView.start();
+    checkFrame("confirm_timezone");
+
+    RebootView rebootView(&display);
+    rebootView.start();
+    checkFrame("reboot");
+    rebootView.drawButtons(false);
+    checkFrame("reboot_confirm_selected");
+
+    PowerOffView powerOffView(&display);
+    powerOffView.start();
+    checkFrame("power_off");
+
+    WiFiResetView wifiResetView(&display);
+    wifiResetView.start();
+    checkFrame("wifi_reset");
+    wifiResetView.showResetMessage();
+    checkFrame("wifi_reset_message", false);
+
+    MenuView menuView(&display);
+    menuView.start();
+    // Selected item at rest on the selection row
+    menuView.draw(testMenu, 0, -MenuView::SELECTION_POSITION * MenuView::SCROLL_UNIT, false, nullptr);
+    checkFrame("menu");
+    // Halfway through scrolling to the next item
+    menuView.draw(testMenu, 1, (1 - MenuView::SELECTION_POSITION) * MenuView::SCROLL_UNIT - MenuView::SCROLL_UNIT / 2, false, nullptr);
+    checkFrame("menu_scrolling");
+    menuView.draw(testMenu, 1, (1 - MenuView::SELECTION_POSITION) * MenuView::SCROLL_UNIT, false, "WiFi: ProofingChamber");
+    checkFrame("menu_banner");
+    // Longer than the screen: scrollbar, and the initial in the corner in letter jump mode
+    menuView.draw(testLongMenu, 4, (4 - MenuView::SELECTION_POSITION) * MenuView::SCROLL_UNIT, false, nullptr);
+    checkFrame("menu_long");
+    menuView.draw(testLongMenu, 4, (4 - MenuView::SELECTION_POSITION) * MenuView::SCROLL_UNIT, true, nullptr);
+    checkFrame("menu_letter_jump");
+
+    if (failures > 0) {
+        std::cerr << "ERROR: " << failures << " screen(s) differ from their golden image" << std::endl;
+        return 1;
+    }
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}